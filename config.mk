@@ -18,24 +18,73 @@ PKG_NAME = parser
 
 
 SOURCES = src/pgtool.cpp src/regex/regex.cpp src/regex/regexparser.cpp \
-	test/cf_grammar.cpp test/lr_parser.cpp test/parse_input.cpp test/parse_input_to_tree.cpp \
+	test/cf_grammar.cpp test/symbol_index.cpp test/lr_parser.cpp test/lalr_parser.cpp test/parse_input.cpp test/compressed_lr_table.cpp test/lr_table_file.cpp test/lr_table_codegen.cpp test/static_lr_table.cpp test/token_view.cpp test/regex_minimization.cpp test/regex_codegen.cpp test/regex_dfa.cpp test/arena_tree.cpp test/flat_tree.cpp test/semantic_actions.cpp test/push_parser.cpp test/incremental_parser.cpp test/error_recovery.cpp test/parse_input_to_tree.cpp \
 	test/grammar_experiment.cpp
 
 
 HEADERS = include/parser/parser.hpp \
           include/parser/parser/cf_grammar.hpp \
 	  include/parser/parser/lr_parser.hpp \
-          include/parser/parser/parse_input.hpp
+	  include/parser/parser/digraph.hpp \
+	  include/parser/parser/symbol_traits.hpp \
+	  include/parser/parser/packed_lr_table.hpp \
+	  include/parser/parser/compressed_lr_table.hpp \
+	  include/parser/parser/lr_table_file.hpp \
+	  include/parser/parser/mapped_lr_table.hpp \
+	  include/parser/parser/lr_table_codegen.hpp \
+	  include/parser/parser/static_lr_table.hpp \
+	  include/parser/parser/token_view.hpp \
+	  include/parser/parser/parse_tree.hpp \
+	  include/parser/parser/flat_tree.hpp \
+	  include/parser/parser/semantic_actions.hpp \
+          include/parser/parser/parse_input.hpp \
+          include/parser/parser/push_parser.hpp \
+          include/parser/parser/incremental_parser.hpp \
+          include/parser/parser/error_recovery.hpp \
+          include/parser/utils/bit_set.hpp
 
-BIN = bin/test_cf_grammar bin/test_lr_parser bin/test_parse_input bin/test_parse_input_to_tree bin/grammar_experiment
+BIN = bin/test_cf_grammar bin/test_symbol_index bin/test_lr_parser bin/test_lalr_parser bin/test_parse_input bin/test_compressed_lr_table bin/test_lr_table_file bin/test_lr_table_codegen bin/test_static_lr_table bin/test_token_view bin/test_regex_minimization bin/test_regex_codegen bin/test_regex_dfa bin/test_arena_tree bin/test_flat_tree bin/test_semantic_actions bin/test_push_parser bin/test_incremental_parser bin/test_error_recovery bin/test_parse_input_to_tree bin/grammar_experiment
 
 bin/pgtool: build/src/pgtool.o build/src/regex/regex.o build/src/regex/regexparser.o
 bin/test_cf_grammar: build/test/cf_grammar.o
+bin/test_symbol_index: build/test/symbol_index.o
 bin/test_lr_parser: build/test/lr_parser.o
+bin/test_lalr_parser: build/test/lalr_parser.o
 bin/test_parse_input: build/test/parse_input.o
+bin/test_compressed_lr_table: build/test/compressed_lr_table.o
+bin/test_lr_table_file: build/test/lr_table_file.o
+bin/test_lr_table_codegen: build/test/lr_table_codegen.o
+bin/test_static_lr_table: build/test/static_lr_table.o
+bin/test_token_view: build/test/token_view.o build/src/regex/regex.o
+bin/test_regex_minimization: build/test/regex_minimization.o build/src/regex/regex.o
+bin/test_regex_codegen: build/test/regex_codegen.o build/src/regex/regex.o
+bin/test_regex_dfa: build/test/regex_dfa.o build/src/regex/regex.o
+bin/test_arena_tree: build/test/arena_tree.o
+bin/test_flat_tree: build/test/flat_tree.o
+bin/test_semantic_actions: build/test/semantic_actions.o
+bin/test_push_parser: build/test/push_parser.o
+bin/test_incremental_parser: build/test/incremental_parser.o
+bin/test_error_recovery: build/test/error_recovery.o
 bin/test_parse_input_to_tree: build/test/parse_input_to_tree.o
 bin/grammar_experiment: build/test/grammar_experiment.o
 
+# The tables included by test/static_lr_table.cpp and the DFA included by
+# test/regex_dfa.cpp are committed copies of the output of a generator test.
+# The output is written to build/, and compared with the committed copy,
+# which is never overwritten:
+build/test/number_list_tables.hpp: bin/test_lr_table_codegen test/number_list_tables.hpp
+build/test/number_lexer_dfa.hpp: bin/test_regex_codegen test/number_lexer_dfa.hpp
+
+build/test/number_list_tables.hpp build/test/number_lexer_dfa.hpp:
+	@echo "[GEN] " $@
+	@$(MKDIR) $(MKDIRFLAGS) $(dir $@)
+	@./$< > $@.tmp
+	@cmp -s $@.tmp $(word 2,$^) || (echo "$(word 2,$^) differs from the output of $<, see $@.tmp"; exit 1)
+	@mv $@.tmp $@
+
+build/test/static_lr_table.o: build/test/number_list_tables.hpp
+build/test/regex_dfa.o: build/test/number_lexer_dfa.hpp
+
 LIB = 
 
 #lib/...: ...
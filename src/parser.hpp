@@ -2,7 +2,20 @@
 #define _PARSER_H_
 
 #include "parser/cf_grammar.hpp"
+#include "parser/symbol_traits.hpp"
 #include "parser/lr_parser.hpp"
+#include "parser/packed_lr_table.hpp"
+#include "parser/compressed_lr_table.hpp"
+#include "parser/mapped_lr_table.hpp"
+#include "parser/static_lr_table.hpp"
+#include "parser/lr_table_codegen.hpp"
+#include "parser/token_view.hpp"
+#include "parser/parse_tree.hpp"
+#include "parser/flat_tree.hpp"
+#include "parser/semantic_actions.hpp"
 #include "parser/parse_input.hpp"
+#include "parser/push_parser.hpp"
+#include "parser/incremental_parser.hpp"
+#include "parser/error_recovery.hpp"
 
 #endif /* _PARSER_H_ */
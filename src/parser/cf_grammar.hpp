@@ -3,8 +3,12 @@
 
 #include <vector>
 #include <set>
+#include <map>
+#include <string>
 #include <utility>
 #include <algorithm>
+#include <cstdint>
+#include <type_traits>
 
 /**
  * An ordered list of symbols. This type is usually used to represent
@@ -36,7 +40,14 @@ public:
                              non_terminals(),
                              symbol_set(),
                              start_symbol(s),
-                             production_rules() {}
+                             production_rules(),
+                             symbol_ids(),
+                             terminal_flags(),
+                             symbol_indices(),
+                             production_lhs_ids(),
+                             production_rhs_ids(),
+                             productions_by_lhs(),
+                             lhs_production_offsets() {}
   virtual ~cf_grammar() {}
 
   /**
@@ -48,6 +59,9 @@ public:
    * of the production rules, the set of symbols by collecting all the symbols
    * in the rhs and lhs, and finally the set of terminal is built by taking the
    * set difference: Terminals = Symbols - NonTerminals.
+   *
+   * The dense symbol ids and the index of the production rules by left hand
+   * side are built at the same time.
    */
   void wrap_up();
 
@@ -108,11 +122,89 @@ public:
 
   std::vector<production_type<symbol_type>> production_rules;
 
-  bool is_terminal(const symbol_type& s) const;
+  /**
+   * \brief Dense symbol ids, built by \c wrap_up.
+   *
+   * The symbol \c symbol_set[i] has id \c i. Since \c symbol_set is sorted,
+   * the ids follow the order of the symbols.
+   */
+  std::map<symbol_type, unsigned int> symbol_ids;
+
+  // terminal_flags[i] is true if the symbol with id i is a terminal:
+  std::vector<bool> terminal_flags;
+
+  // Position of the symbol with id i in terminals or in non_terminals:
+  std::vector<unsigned int> symbol_indices;
+
+  // The production rules, with each symbol replaced by its id:
+  std::vector<unsigned int> production_lhs_ids;
+  std::vector<std::vector<unsigned int>> production_rhs_ids;
+
+  /**
+   * \brief Production rules grouped by left hand side.
+   *
+   * The ids of the production rules of the symbol with id i are stored in
+   * \c productions_by_lhs, from \c lhs_production_offsets[i] to
+   * \c lhs_production_offsets[i + 1]. This range is empty for terminals.
+   */
+  std::vector<unsigned int> productions_by_lhs;
+  std::vector<unsigned int> lhs_production_offsets;
+
+  unsigned int symbol_id(const symbol_type& s) const {
+    const auto id(symbol_ids.find(s));
+    if (id == symbol_ids.end())
+      throw std::string("cf_grammar::symbol_id()"
+                        " - This symbol does not belong to the grammar.");
+    return id->second;
+  }
+
+  bool is_terminal_id(unsigned int id) const { return terminal_flags[id]; }
+
+  bool is_terminal(const symbol_type& s) const {
+    const auto id(symbol_ids.find(s));
+    return id != symbol_ids.end() and terminal_flags[id->second];
+  }
   bool is_non_terminal(const symbol_type& s) const {
-    return std::find(non_terminals.begin(),
-                     non_terminals.end(),
-                     s) != non_terminals.end();
+    const auto id(symbol_ids.find(s));
+    return id != symbol_ids.end() and not terminal_flags[id->second];
+  }
+
+  /**
+   * \brief Hash of the start symbol and of the production rules.
+   *
+   * Two grammars with the same fingerprint are, with a very high probability,
+   * the same grammar, with the same production ids. It is used to reject the
+   * stored parse tables of another grammar. The hash is computed on the
+   * binary representation of the symbols, which must be trivially copyable.
+   */
+  std::uint64_t fingerprint() const {
+    static_assert(std::is_trivially_copyable<symbol_type>::value,
+                  "The fingerprint requires a trivially copyable symbol type.");
+
+    // 64 bits FNV-1a hash:
+    std::uint64_t h(0xcbf29ce484222325ull);
+    auto hash = [&h](const void* data, std::size_t size) {
+      const unsigned char* bytes(static_cast<const unsigned char*>(data));
+      for (std::size_t i(0); i < size; ++i)
+        h = (h ^ bytes[i]) * 0x100000001b3ull;
+    };
+
+    hash(&start_symbol, sizeof(symbol_type));
+    for (const auto& p: production_rules) {
+      const std::uint64_t length(p.second.size());
+      hash(&length, sizeof(length));
+      hash(&p.first, sizeof(symbol_type));
+      for (const auto& s: p.second)
+        hash(&s, sizeof(symbol_type));
+    }
+    return h;
+  }
+
+  std::vector<unsigned int>::const_iterator lhs_productions_begin(unsigned int id) const {
+    return productions_by_lhs.begin() + lhs_production_offsets[id];
+  }
+  std::vector<unsigned int>::const_iterator lhs_productions_end(unsigned int id) const {
+    return productions_by_lhs.begin() + lhs_production_offsets[id + 1];
   }
 };
 
@@ -134,8 +226,42 @@ void cf_grammar<symbol_type>::wrap_up() {
                            terminals.begin()));
   terminals.resize(it - terminals.begin());
 
-  non_terminals.insert(non_terminals.begin(), nt.begin(), nt.end());
-  symbol_set.insert(symbol_set.begin(), s.begin(), s.end());
+  non_terminals.assign(nt.begin(), nt.end());
+  symbol_set.assign(s.begin(), s.end());
+
+  // Dense symbol ids:
+  symbol_ids.clear();
+  terminal_flags.assign(symbol_set.size(), true);
+  symbol_indices.assign(symbol_set.size(), 0);
+  for (unsigned int i(0); i < symbol_set.size(); ++i)
+    symbol_ids[symbol_set[i]] = i;
+  for (unsigned int i(0); i < terminals.size(); ++i)
+    symbol_indices[symbol_ids[terminals[i]]] = i;
+  for (unsigned int i(0); i < non_terminals.size(); ++i) {
+    terminal_flags[symbol_ids[non_terminals[i]]] = false;
+    symbol_indices[symbol_ids[non_terminals[i]]] = i;
+  }
+
+  production_lhs_ids.resize(production_rules.size());
+  production_rhs_ids.resize(production_rules.size());
+  for (unsigned int i(0); i < production_rules.size(); ++i) {
+    production_lhs_ids[i] = symbol_ids[production_rules[i].first];
+    production_rhs_ids[i].resize(production_rules[i].second.size());
+    for (unsigned int j(0); j < production_rules[i].second.size(); ++j)
+      production_rhs_ids[i][j] = symbol_ids[production_rules[i].second[j]];
+  }
+
+  // Index of the production rules by left hand side (counting sort):
+  lhs_production_offsets.assign(symbol_set.size() + 1, 0);
+  for (unsigned int i(0); i < production_rules.size(); ++i)
+    ++lhs_production_offsets[production_lhs_ids[i] + 1];
+  for (unsigned int i(0); i < symbol_set.size(); ++i)
+    lhs_production_offsets[i + 1] += lhs_production_offsets[i];
+
+  productions_by_lhs.resize(production_rules.size());
+  std::vector<unsigned int> next(lhs_production_offsets.begin(), lhs_production_offsets.end() - 1);
+  for (unsigned int i(0); i < production_rules.size(); ++i)
+    productions_by_lhs[next[production_lhs_ids[i]]++] = i;
 }
 
 #endif /* CF_GRAMMAR_H */
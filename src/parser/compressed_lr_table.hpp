@@ -0,0 +1,368 @@
+#ifndef _COMPRESSED_LR_TABLE_H_
+#define _COMPRESSED_LR_TABLE_H_
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <algorithm>
+
+#include "packed_lr_table.hpp"
+
+
+/**
+ * \brief Row displacement packing of a sparse table
+ *
+ * The non empty entries of every row are overlaid in one shared array: row r
+ * is stored from offset \c base[r], and \c check records which row owns each
+ * cell. An entry (r, c) is present iff \c check[base[r] + c] == r. Rows are
+ * placed from the densest to the sparsest, each at the first offset where
+ * all its entries fall on free cells (first fit, as in yacc and bison).
+ */
+template<typename index_type>
+class comb_vector {
+public:
+  static const index_type no_row = std::numeric_limits<index_type>::max();
+
+  comb_vector(): base(), values(), check() {}
+
+  /**
+   * \brief Pack the rows, given as lists of (column, value) pairs.
+   */
+  explicit comb_vector(const std::vector<std::vector<std::pair<std::size_t, index_type>>>& rows)
+    : base(rows.size(), 0), values(), check() {
+    if (rows.size() >= no_row)
+      throw std::string("comb_vector::comb_vector()"
+                        " - Too many rows for the index type.");
+
+    std::vector<std::size_t> order(rows.size());
+    for (std::size_t i(0); i < order.size(); ++i)
+      order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return rows[a].size() > rows[b].size();
+      });
+
+    // free_cell is the first cell which may be free, to start the search:
+    std::size_t free_cell(0);
+    for (const auto r: order) {
+      if (rows[r].empty())
+        break;
+
+      const std::size_t first_column(rows[r].front().first);
+      std::size_t offset(free_cell > first_column ? free_cell - first_column : 0);
+      while (not fits(rows[r], offset))
+        ++offset;
+
+      base[r] = narrow(offset);
+      for (const auto& entry: rows[r]) {
+        if (offset + entry.first >= values.size()) {
+          values.resize(offset + entry.first + 1, 0);
+          check.resize(offset + entry.first + 1, no_row);
+        }
+        values[offset + entry.first] = entry.second;
+        check[offset + entry.first] = static_cast<index_type>(r);
+      }
+
+      while (free_cell < check.size() and check[free_cell] != no_row)
+        ++free_cell;
+    }
+  }
+
+  /**
+   * \brief Lookup the entry (row, column). Return false if it is empty.
+   */
+  bool find(std::size_t row, std::size_t column, index_type& value) const {
+    const std::size_t i(base[row] + column);
+    if (i < check.size() and check[i] == row) {
+      value = values[i];
+      return true;
+    }
+    return false;
+  }
+
+  std::size_t size_in_bytes() const {
+    return (base.size() + values.size() + check.size()) * sizeof(index_type);
+  }
+
+private:
+  std::vector<index_type> base;
+  std::vector<index_type> values;
+  std::vector<index_type> check;
+
+  bool fits(const std::vector<std::pair<std::size_t, index_type>>& row, std::size_t offset) const {
+    for (const auto& entry: row)
+      if (offset + entry.first < check.size() and check[offset + entry.first] != no_row)
+        return false;
+    return true;
+  }
+
+  static index_type narrow(std::size_t value) {
+    if (value >= no_row)
+      throw std::string("comb_vector::comb_vector()"
+                        " - The packed table does not fit in the index type.");
+    return static_cast<index_type>(value);
+  }
+};
+
+template<typename index_type>
+const index_type comb_vector<index_type>::no_row;
+
+
+/**
+ * \brief Optimizations applied by \c compressed_lr_table
+ */
+struct table_options {
+  bool default_reductions = true;
+  bool unit_rule_elimination = false;
+
+  // Ids of the productions which must be reduced explicitly.
+  std::set<std::size_t> semantic_productions;
+};
+
+
+/**
+ * \brief Compressed representation of the tables of a \c lr_parser
+ *
+ * The action table is compressed in two steps. First, the most frequent
+ * reduction of each state becomes its default reduction, which replaces its
+ * entries and its error entries. Then, the remaining entries are packed with
+ * a \c comb_vector. The goto table is packed likewise, by non terminal column,
+ * with the most frequent target of each column as default.
+ *
+ * Default reductions may delay the detection of a syntax error by a few
+ * reductions, but an erroneous token is never shifted: this is the behaviour
+ * of yacc and bison.
+ *
+ * Optionally, the reductions by unit productions A -> X are bypassed: when a
+ * transition on X leads to a state whose only action is the reduction
+ * A -> X, the transition is redirected to the target of A. This saves a
+ * reduce step, and a node in the parse tree, for each link of the chains of
+ * unit productions of the grammar. The productions with a semantic action
+ * are listed in \c table_options::semantic_productions and never bypassed.
+ *
+ * This class provides the table interface of the parse functions, see
+ * packed_lr_table.hpp.
+ */
+template<typename symbol_t, typename index_t = std::uint16_t>
+class compressed_lr_table {
+public:
+  typedef symbol_t symbol_type;
+  typedef index_t index_type;
+  typedef lr_action<index_type> action_type;
+
+  explicit compressed_lr_table(const lr_parser<symbol_type>& parser,
+                               const table_options& options = table_options());
+
+  std::size_t state_count() const { return default_reductions.size(); }
+  std::size_t terminal_count() const { return terminals.size(); }
+  std::size_t non_terminal_count() const { return non_terminals.size(); }
+
+  std::size_t accepting_state() const { return accepting; }
+
+  bool find_terminal(const symbol_type& s, std::size_t& column) const {
+    return terminal_index.find(s, column);
+  }
+
+  action_type action(std::size_t state, std::size_t column) const {
+    index_type value(0);
+    if (actions.find(state, column, value))
+      return decode(value);
+    if (default_reductions[state])
+      return reduce_action(default_reductions[state] - 1);
+    return action_type{action_type::error, 0, 0, 0};
+  }
+
+  std::size_t goto_state(std::size_t state, std::size_t column) const {
+    index_type value(0);
+    if (gotos.find(column, state, value))
+      return value;
+    return default_gotos[column];
+  }
+
+  const symbol_type& terminal(std::size_t column) const { return terminals[column]; }
+  const symbol_type& non_terminal(std::size_t column) const { return non_terminals[column]; }
+
+  /**
+   * \brief Default reduction of a state: the production id + 1, or 0.
+   */
+  std::size_t default_reduction(std::size_t state) const { return default_reductions[state]; }
+
+  /**
+   * \brief Size of the unit rule elimination in the tables.
+   *
+   * This is the number of action and goto entries redirected past a unit
+   * reduction, each entry counting for the length of the chain of unit
+   * reductions it skips. It measures the tables, not a parse: the number of
+   * reductions saved while parsing an input depends on the transitions the
+   * input takes, and is found by counting the reductions of the parse.
+   */
+  std::size_t eliminated_unit_reductions() const { return eliminated_reductions; }
+
+  std::size_t size_in_bytes() const {
+    return actions.size_in_bytes() + gotos.size_in_bytes()
+      + (default_reductions.size() + default_gotos.size()
+         + rule_lengths.size() + rule_lhs.size()) * sizeof(index_type);
+  }
+
+private:
+  std::size_t accepting;
+  std::size_t eliminated_reductions;
+
+  // Actions values are encoded as: state + 1 for a shift, and
+  // state_count() + production id + 1 for a reduction.
+  comb_vector<index_type> actions;
+  std::vector<index_type> default_reductions;
+
+  comb_vector<index_type> gotos;
+  std::vector<index_type> default_gotos;
+
+  std::vector<index_type> rule_lengths;
+  std::vector<index_type> rule_lhs;
+
+  std::vector<symbol_type> terminals;
+  std::vector<symbol_type> non_terminals;
+  symbol_index<symbol_type> terminal_index;
+
+  action_type reduce_action(std::size_t production_id) const {
+    return action_type{action_type::reduce,
+                       static_cast<index_type>(production_id),
+                       rule_lengths[production_id],
+                       rule_lhs[production_id]};
+  }
+
+  action_type decode(index_type value) const {
+    if (value <= default_reductions.size())
+      return action_type{action_type::shift, static_cast<index_type>(value - 1), 0, 0};
+    return reduce_action(value - default_reductions.size() - 1);
+  }
+
+  static index_type narrow(std::size_t value) {
+    if (value > std::numeric_limits<index_type>::max())
+      throw std::string("compressed_lr_table::compressed_lr_table()"
+                        " - The parser does not fit in the index type.");
+    return static_cast<index_type>(value);
+  }
+};
+
+
+template<typename symbol_t, typename index_t>
+compressed_lr_table<symbol_t, index_t>::compressed_lr_table(const lr_parser<symbol_type>& parser,
+                                                             const table_options& options)
+  : accepting(parser.accepting_state),
+    eliminated_reductions(0),
+    actions(),
+    default_reductions(parser.transitions_table.size(), 0),
+    gotos(),
+    default_gotos(parser.non_terminal_map.size(), 0),
+    rule_lengths(parser.rule_lengths.size(), 0),
+    rule_lhs(parser.rule_lengths.size(), 0),
+    terminals(parser.terminal_map.size()),
+    non_terminals(parser.non_terminal_map.size()),
+    terminal_index(parser.terminal_index) {
+  std::vector<std::vector<int>> transitions(parser.transitions_table);
+  std::vector<std::vector<int>> goto_table(parser.goto_table);
+  const std::size_t states(transitions.size());
+  narrow(states + rule_lengths.size() + 1);
+
+  for (const auto& item: parser.terminal_map)
+    terminals[item.second] = item.first;
+  narrow(terminals.size());
+  for (const auto& item: parser.non_terminal_map)
+    non_terminals[item.second] = item.first;
+
+  for (std::size_t i(0); i < rule_lengths.size(); ++i) {
+    rule_lengths[i] = narrow(parser.rule_lengths[i]);
+    rule_lhs[i] = narrow(parser.reduce_columns[i]);
+  }
+
+  if (options.unit_rule_elimination) {
+    // unit_rules[s] is the unit production which is the only action of the
+    // state s, or -1:
+    std::vector<int> unit_rules(states, -1);
+    for (std::size_t i(0); i < states; ++i) {
+      int reduction(0);
+      bool single(i != accepting);
+      for (const int entry: transitions[i])
+        if (entry > 0 or (entry < 0 and reduction != 0 and entry != reduction))
+          single = false;
+        else if (entry < 0)
+          reduction = entry;
+
+      const std::size_t production_id(- reduction - 1);
+      if (single and reduction != 0 and rule_lengths[production_id] == 1
+          and not options.semantic_productions.count(production_id))
+        unit_rules[i] = production_id;
+    }
+
+    // Follow the chain of unit reductions from the target of a transition
+    // leaving the state i. As the grammar is unambiguous, there is no cycle.
+    auto bypass = [&](std::size_t i, int target) {
+      while (unit_rules[target - 1] >= 0) {
+        target = parser.goto_table[i][rule_lhs[unit_rules[target - 1]]];
+        ++eliminated_reductions;
+      }
+      return target;
+    };
+
+    for (std::size_t i(0); i < states; ++i) {
+      for (int& entry: transitions[i])
+        if (entry > 0)
+          entry = bypass(i, entry);
+      for (int& entry: goto_table[i])
+        if (entry > 0)
+          entry = bypass(i, entry);
+    }
+  }
+
+  std::vector<std::vector<std::pair<std::size_t, index_type>>> rows(states);
+  for (std::size_t i(0); i < states; ++i) {
+    // The most frequent reduction of the row becomes the default one:
+    if (options.default_reductions) {
+      std::map<int, std::size_t> reductions;
+      for (const int entry: transitions[i])
+        if (entry < 0)
+          ++reductions[entry];
+
+      std::size_t count(0);
+      for (const auto& reduction: reductions)
+        if (reduction.second > count) {
+          count = reduction.second;
+          default_reductions[i] = narrow(- reduction.first);
+        }
+    }
+
+    for (std::size_t j(0); j < transitions[i].size(); ++j) {
+      const int entry(transitions[i][j]);
+      if (entry > 0)
+        rows[i].push_back(std::make_pair(j, narrow(entry)));
+      else if (entry < 0 and static_cast<std::size_t>(- entry) != default_reductions[i])
+        rows[i].push_back(std::make_pair(j, narrow(states - entry)));
+    }
+  }
+  actions = comb_vector<index_type>(rows);
+
+  // Gotos, by non terminal column:
+  std::vector<std::vector<std::pair<std::size_t, index_type>>> columns(default_gotos.size());
+  for (std::size_t j(0); j < default_gotos.size(); ++j) {
+    std::map<int, std::size_t> targets;
+    for (std::size_t i(0); i < states; ++i)
+      if (goto_table[i][j] > 0)
+        ++targets[goto_table[i][j]];
+
+    std::size_t count(0);
+    for (const auto& target: targets)
+      if (target.second > count) {
+        count = target.second;
+        default_gotos[j] = narrow(target.first - 1);
+      }
+
+    for (std::size_t i(0); i < states; ++i)
+      if (goto_table[i][j] > 0 and static_cast<std::size_t>(goto_table[i][j] - 1) != default_gotos[j])
+        columns[j].push_back(std::make_pair(i, narrow(goto_table[i][j] - 1)));
+  }
+  gotos = comb_vector<index_type>(columns);
+}
+
+#endif /* _COMPRESSED_LR_TABLE_H_ */
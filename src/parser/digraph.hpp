@@ -0,0 +1,86 @@
+#ifndef _DIGRAPH_H_
+#define _DIGRAPH_H_
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+/**
+ * \brief Union of sets along the edges of a relation.
+ *
+ * Given a relation R over the indices 0..n-1 and an initial set F'(x) for each
+ * index, compute F(x) = F'(x) U { F(y) | x R y }, which is the smallest solution
+ * of the set equations. This is the DIGRAPH algorithm of DeRemer and Pennello
+ * (Efficient Computation of LALR(1) Look-Ahead Sets, 1982): each strongly
+ * connected component of R is detected during a depth first traversal and
+ * all its members share the same set, so that every edge is visited once.
+ *
+ * \param relation relation[x] is the list of the y such that x R y.
+ * \param f On entry, the initial sets F'(x). On return, the sets F(x). The
+ *          set type must provide operator|= and assignment.
+ */
+template<typename set_type>
+void digraph(const std::vector<std::vector<unsigned int>>& relation,
+             std::vector<set_type>& f) {
+  const unsigned int infinity(std::numeric_limits<unsigned int>::max());
+  std::vector<unsigned int> depth(relation.size(), 0);
+  std::vector<unsigned int> stack;
+
+  // Explicit traversal stack, to avoid deep recursions on long chains of the
+  // relation. Each frame holds the vertex, its next edge to visit, and the
+  // depth it was assigned when it was pushed.
+  struct frame {
+    unsigned int vertex;
+    unsigned int edge;
+    unsigned int depth;
+  };
+  std::vector<frame> path;
+
+  for (unsigned int root(0); root < relation.size(); ++root) {
+    if (depth[root] != 0)
+      continue;
+
+    stack.push_back(root);
+    depth[root] = stack.size();
+    path.push_back(frame{root, 0, depth[root]});
+
+    while (not path.empty()) {
+      const unsigned int x(path.back().vertex);
+
+      if (path.back().edge < relation[x].size()) {
+        const unsigned int y(relation[x][path.back().edge++]);
+        if (depth[y] == 0) {
+          stack.push_back(y);
+          depth[y] = stack.size();
+          path.push_back(frame{y, 0, depth[y]});
+        } else {
+          depth[x] = std::min(depth[x], depth[y]);
+          f[x] |= f[y];
+        }
+        continue;
+      }
+
+      // All the edges of x have been visited. If x is the root of a strongly
+      // connected component, every member of the component gets its set:
+      if (depth[x] == path.back().depth) {
+        unsigned int top(0);
+        do {
+          top = stack.back();
+          stack.pop_back();
+          depth[top] = infinity;
+          if (top != x)
+            f[top] = f[x];
+        } while (top != x);
+      }
+      path.pop_back();
+
+      if (not path.empty()) {
+        const unsigned int parent(path.back().vertex);
+        depth[parent] = std::min(depth[parent], depth[x]);
+        f[parent] |= f[x];
+      }
+    }
+  }
+}
+
+#endif /* _DIGRAPH_H_ */
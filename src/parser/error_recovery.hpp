@@ -0,0 +1,186 @@
+#ifndef _ERROR_RECOVERY_H_
+#define _ERROR_RECOVERY_H_
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "parse_input.hpp"
+
+
+/**
+ * \brief Syntax error reported by parse_input_to_tree_with_recovery
+ */
+template<typename token_type>
+struct parse_diagnostic {
+  typedef typename token_type::symbol_type symbol_type;
+
+  token_type unexpected_token;
+  std::vector<symbol_type> expected_symbols;
+};
+
+// Production id of the nodes built by the error recovery:
+const unsigned int error_production_id(std::numeric_limits<unsigned int>::max());
+
+// Number of tokens to shift after an error before the next one is reported:
+const unsigned int error_recovery_shifts(3);
+
+
+/**
+ * \brief The reduction done in \c state on every valid lookahead, if any
+ *
+ * Otherwise, an error action is returned.
+ */
+template<typename table_type>
+typename table_type::action_type default_reduction(const table_type& table, std::size_t state) {
+  using action_type = typename table_type::action_type;
+
+  action_type reduction{action_type::error, 0, 0, 0};
+  for (std::size_t i(0); i < table.terminal_count(); ++i) {
+    const action_type action(table.action(state, i));
+    if (action.kind == action_type::shift
+        or (action.kind == action_type::reduce and reduction.kind == action_type::reduce
+            and action.target != reduction.target))
+      return action_type{action_type::error, 0, 0, 0};
+    if (action.kind == action_type::reduce)
+      reduction = action;
+  }
+  return reduction;
+}
+
+
+/**
+ * \brief Parse the input to a tree, recovering from the syntax errors
+ *
+ * Each syntax error is added to \c diagnostics and the parse goes on, as in
+ * yacc. The terminal \c error_symbol stands for the erroneous input in the
+ * productions of the grammar, such as <tt>statement = error semicolon</tt>.
+ * On an error, the reductions which do not depend on the lookahead are done
+ * first, as with the default reductions of yacc, so that the constructs
+ * completed before the error are kept. Then, the states are popped until one
+ * shifts \c error_symbol, and the tokens are skipped until one is valid after
+ * it. The popped nodes and the leaves of the skipped tokens are the children
+ * of a node of \c error_symbol, whose production id is error_production_id,
+ * shifted as the error terminal.
+ *
+ * If no state on the stack shifts \c error_symbol, which is the case of the
+ * grammars without error productions, the tokens are skipped until one is
+ * valid in the current state, and are not in the tree.
+ *
+ * Another error is reported only after error_recovery_shifts tokens have
+ * been shifted, and until then, the unexpected tokens are skipped. If the
+ * input cannot be recovered before \c eoi_symbol, the nodes built so far are
+ * returned as the children of a node of \c error_symbol: the tree is never
+ * lost, and nothing is thrown on a syntax error.
+ *
+ * The tables are accessed through the interface documented in
+ * packed_lr_table.hpp.
+ */
+template<class token_source_type, typename tree_factory_type, typename table_type>
+typename tree_factory_type::node_type*
+parse_input_to_tree_with_recovery(const table_type& table,
+                                  token_source_type& input,
+                                  tree_factory_type& tree_factory,
+                                  const typename token_source_type::symbol_type& error_symbol,
+                                  const typename token_source_type::symbol_type& eoi_symbol,
+                                  std::vector<parse_diagnostic<typename token_source_type::token_type> >& diagnostics) {
+  using token_type = typename token_source_type::token_type;
+  using symbol_type = typename token_source_type::symbol_type;
+  using node_type = typename tree_factory_type::node_type;
+  using action_type = typename table_type::action_type;
+
+  tree_output<tree_factory_type> output(tree_factory);
+  std::vector<node_type*>& node_stack(output.node_stack);
+
+  std::vector<std::size_t> state_stack;
+  state_stack.reserve(initial_parse_stack_capacity);
+  state_stack.push_back(0);
+
+  std::size_t error_column(0);
+  const bool error_productions(table.find_terminal(error_symbol, error_column));
+  unsigned int shifts_to_report(0);
+  bool recovering(false);
+
+  auto next_action = [&](std::size_t state) {
+    std::size_t terminal_id(0);
+    if (not table.find_terminal(input.get().symbol, terminal_id))
+      return action_type{action_type::error, 0, 0, 0};
+    return table.action(state, terminal_id);
+  };
+
+  // Replace the nodes from first to the top of the stack by an error node:
+  auto build_error_node = [&](std::size_t first) {
+    node_type** const end(node_stack.data() + node_stack.size());
+    node_type* n(tree_factory.build_node(node_stack.data() + first, end,
+                                         error_production_id, error_symbol));
+    pop(node_stack, node_stack.size() - first);
+    return n;
+  };
+
+  while(state_stack.back() != table.accepting_state()) {
+    const action_type action(next_action(state_stack.back()));
+
+    if(action.kind == action_type::shift) {
+      shift_parse_stacks(action, state_stack, output, input);
+      input.next();
+      if (shifts_to_report > 0)
+        --shifts_to_report;
+    } else if(action.kind == action_type::reduce) {
+      reduce_parse_stacks(table, action, state_stack, output, input.get());
+    } else {
+      if (not recovering) {
+        if (shifts_to_report > 0) {
+          // An error following a recovery: the token is skipped.
+          if (input.get().symbol == eoi_symbol)
+            return build_error_node(0);
+          input.next();
+          continue;
+        }
+
+        std::vector<symbol_type> expected_symbols(expected_terminals(table, state_stack.back()));
+        expected_symbols.erase(std::remove(expected_symbols.begin(), expected_symbols.end(), error_symbol),
+                               expected_symbols.end());
+        diagnostics.push_back(parse_diagnostic<token_type>{input.get(), expected_symbols});
+        recovering = true;
+      }
+
+      const action_type default_action(default_reduction(table, state_stack.back()));
+      if (default_action.kind == action_type::reduce) {
+        reduce_parse_stacks(table, default_action, state_stack, output, input.get());
+        continue;
+      }
+      recovering = false;
+      shifts_to_report = error_recovery_shifts;
+
+      std::size_t depth(state_stack.size());
+      while (error_productions and depth > 0
+             and table.action(state_stack[depth - 1], error_column).kind != action_type::shift)
+        --depth;
+
+      if (error_productions and depth > 0) {
+        pop(state_stack, state_stack.size() - depth);
+        const std::size_t error_state(table.action(state_stack.back(), error_column).target);
+
+        while (next_action(error_state).kind == action_type::error and input.get().symbol != eoi_symbol) {
+          output.shift(input);
+          input.next();
+        }
+        if (next_action(error_state).kind == action_type::error)
+          return build_error_node(0);
+
+        node_stack.push_back(build_error_node(depth - 1));
+        state_stack.push_back(error_state);
+      } else {
+        while (next_action(state_stack.back()).kind == action_type::error
+               and input.get().symbol != eoi_symbol)
+          input.next();
+        if (next_action(state_stack.back()).kind == action_type::error)
+          return build_error_node(0);
+      }
+    }
+  }
+
+  return output.result();
+}
+
+#endif /* _ERROR_RECOVERY_H_ */
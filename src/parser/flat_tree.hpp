@@ -0,0 +1,110 @@
+#ifndef _FLAT_TREE_H_
+#define _FLAT_TREE_H_
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "token_view.hpp"
+
+
+/**
+ * \brief Record of a flat tree, written by parse_input_to_flat_tree
+ *
+ * A flat tree is the post-order sequence of the shifts and the reductions
+ * of a parse: the records of a subtree are contiguous, and end with the
+ * record of its root. \c size is the number of records of the subtree, so
+ * that its records are [index + 1 - size, index + 1).
+ *
+ * The span of a terminal is the span of its token, if the token has one
+ * (see token_view.hpp). The span of a production covers its children.
+ */
+template<typename symbol_t>
+struct flat_tree_record {
+  typedef symbol_t symbol_type;
+
+  // Production id of the terminals:
+  static const std::uint32_t terminal_id = std::numeric_limits<std::uint32_t>::max();
+
+  symbol_type symbol;
+  std::uint32_t production_id;
+  std::uint32_t child_count;
+  std::uint32_t size;
+  lexeme_span span;
+
+  bool is_terminal() const { return production_id == terminal_id; }
+};
+
+namespace flat_tree_detail {
+  template<typename token_type>
+  auto token_span(const token_type& t, int) -> decltype(lexeme_span(t.span)) {
+    return t.span;
+  }
+
+  template<typename token_type>
+  lexeme_span token_span(const token_type&, long) {
+    return lexeme_span{0, 0};
+  }
+}
+
+
+/**
+ * \brief Cursor which walks a flat tree as a tree
+ *
+ * The children of a node are reached from the last one, since it is the
+ * record before its parent: last_child() and previous_sibling() are constant
+ * time, child(i) walks the siblings after the child i.
+ */
+template<typename symbol_t>
+class flat_tree_cursor {
+public:
+  typedef flat_tree_record<symbol_t> record_type;
+
+  /**
+   * \brief Cursor on the root of the tree, which is its last record.
+   */
+  explicit flat_tree_cursor(const std::vector<record_type>& records)
+    : records(&records), index(records.size() - 1), position(0) {}
+
+  const record_type& operator*() const { return (*records)[index]; }
+  const record_type* operator->() const { return &(*records)[index]; }
+
+  std::size_t get_index() const { return index; }
+
+  // Rank of the node among its siblings:
+  std::size_t get_position() const { return position; }
+
+  bool is_terminal() const { return (*this)->is_terminal(); }
+  std::size_t child_count() const { return (*this)->child_count; }
+
+  flat_tree_cursor last_child() const {
+    return flat_tree_cursor(*records, index - 1, child_count() - 1);
+  }
+
+  bool has_previous_sibling() const { return position > 0; }
+
+  flat_tree_cursor previous_sibling() const {
+    return flat_tree_cursor(*records, index - (*this)->size, position - 1);
+  }
+
+  flat_tree_cursor child(std::size_t i) const {
+    flat_tree_cursor c(last_child());
+    while (c.position > i)
+      c = c.previous_sibling();
+    return c;
+  }
+
+  // The records of the subtree, in post-order:
+  const record_type* begin() const { return records->data() + index + 1 - (*this)->size; }
+  const record_type* end() const { return records->data() + index + 1; }
+
+private:
+  flat_tree_cursor(const std::vector<record_type>& records, std::size_t index, std::size_t position)
+    : records(&records), index(index), position(position) {}
+
+  const std::vector<record_type>* records;
+  std::size_t index;
+  std::size_t position;
+};
+
+#endif /* _FLAT_TREE_H_ */
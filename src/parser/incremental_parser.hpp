@@ -0,0 +1,301 @@
+#ifndef _INCREMENTAL_PARSER_H_
+#define _INCREMENTAL_PARSER_H_
+
+#include <limits>
+#include <vector>
+
+#include "parse_input.hpp"
+
+
+/**
+ * \brief Node of the trees built by incremental_parser
+ *
+ * Each node records the parse state on top of the stack when it was pushed,
+ * and its width, the number of tokens it covers, so that the position of a
+ * node is known from its siblings and its parent only.
+ */
+template<typename token_type>
+struct incremental_node {
+  typedef typename token_type::symbol_type symbol_type;
+
+  // Production id of the terminals:
+  static const unsigned int terminal_id = std::numeric_limits<unsigned int>::max();
+
+  symbol_type symbol;
+  unsigned int production_id;
+
+  // Column of the left hand side in the goto table, for the productions:
+  std::size_t lhs;
+
+  std::size_t state;
+  std::size_t width;
+
+  std::vector<incremental_node*> children;
+  token_type token;
+
+  incremental_node(const symbol_type& s, unsigned int production_id, std::size_t lhs, std::size_t state)
+    : symbol(s), production_id(production_id), lhs(lhs), state(state), width(0), children(), token() {}
+
+  incremental_node(const token_type& t)
+    : symbol(t.symbol), production_id(terminal_id), lhs(0), state(0), width(1), children(), token(t) {}
+
+  // The trees of long lists are deep, hence the nodes are not deleted recursively:
+  ~incremental_node() {
+    std::vector<incremental_node*> nodes;
+    nodes.swap(children);
+    while (not nodes.empty()) {
+      incremental_node* n(nodes.back());
+      nodes.pop_back();
+      nodes.insert(nodes.end(), n->children.begin(), n->children.end());
+      n->children.clear();
+      delete n;
+    }
+  }
+
+  incremental_node(const incremental_node&) = delete;
+  incremental_node& operator=(const incremental_node&) = delete;
+
+  bool is_terminal() const { return production_id == terminal_id; }
+};
+
+
+/**
+ * \brief Parser which updates its tree after an edit of the tokens, reusing
+ * the unchanged subtrees
+ *
+ * This is the state matching method of Wagner and Graham: the input of a
+ * reparse is the sequence of the subtrees of the previous tree, with the
+ * edited tokens in place of the subtrees which cover them. A subtree is
+ * pushed as a whole if the parser is in the state in which it was pushed
+ * before, and if the token which follows it is unchanged, since its
+ * reductions depend on this lookahead. Otherwise, it is broken down into its
+ * children. The work done is proportional to the size of the edit and to the
+ * depth of the tree, not to the size of the input.
+ *
+ * The tables are accessed through the interface documented in
+ * packed_lr_table.hpp. The tokens are numbered from 0, and the last one must
+ * be the end of input token. The root of the tree is a node of the start
+ * rule, which the parse functions never reduce, whose last child is the end
+ * of input token: \c start is its symbol.
+ *
+ * A reparse is transactional: if the new input is invalid, parse_error is
+ * thrown and the previous tree is kept.
+ */
+template<typename table_type, typename token_t>
+class incremental_parser {
+public:
+  using token_type = token_t;
+  using symbol_type = typename token_type::symbol_type;
+  using node_type = incremental_node<token_type>;
+  using action_type = typename table_type::action_type;
+
+  incremental_parser(const table_type& table, const symbol_type& start)
+    : table(table), start(start), root(nullptr), reused(0) {}
+
+  ~incremental_parser() { delete root; }
+
+  incremental_parser(const incremental_parser&) = delete;
+  incremental_parser& operator=(const incremental_parser&) = delete;
+
+  /**
+   * \brief Parse the tokens, which replace the whole last parsed input.
+   */
+  const node_type* parse(const std::vector<token_type>& tokens) {
+    return reparse(0, root ? root->width : 0, tokens);
+  }
+
+  /**
+   * \brief Replace the tokens [begin, end) of the last parsed input by
+   * \c tokens, and update the tree.
+   */
+  const node_type* reparse(std::size_t begin, std::size_t end, const std::vector<token_type>& tokens);
+
+  const node_type* tree() const { return root; }
+
+  // The number of subtrees of the previous tree reused by the last parse:
+  std::size_t reused_subtrees() const { return reused; }
+
+private:
+  // Item of the input of a reparse, as a stack whose top is the next item:
+  struct input_item {
+    node_type* node;
+    std::size_t start;
+    bool old;
+  };
+
+  const table_type& table;
+  symbol_type start;
+  node_type* root;
+  std::size_t reused;
+
+  // Output of the reductions of a reparse, see parse_input_to_output. The
+  // shifts are done by reparse, which reuses the old leaves:
+  struct reparse_output {
+    std::vector<node_type*> node_stack;
+    std::vector<node_type*>& created;
+
+    void reduce(const action_type& action, const symbol_type& lhs, std::size_t state, const token_type&) {
+      node_type* p(new node_type(lhs, action.target, action.lhs, state));
+      created.push_back(p);
+      p->children.assign(node_stack.end() - action.length, node_stack.end());
+      for (auto c: p->children)
+        p->width += c->width;
+      pop(node_stack, action.length);
+      node_stack.push_back(p);
+    }
+  };
+
+  // Delete nodes whose children are deleted separately, or kept:
+  static void delete_nodes(std::vector<node_type*>& nodes) {
+    for (auto n: nodes) {
+      n->children.clear();
+      delete n;
+    }
+    nodes.clear();
+  }
+
+  static const node_type* first_terminal(const node_type* n) {
+    while (not n->is_terminal()) {
+      std::size_t i(0);
+      while (n->children[i]->width == 0)
+        ++i;
+      n = n->children[i];
+    }
+    return n;
+  }
+
+  static void push_children(std::vector<input_item>& input, const input_item& item) {
+    std::size_t start(item.start + item.node->width);
+    for (auto c(item.node->children.rbegin()); c != item.node->children.rend(); ++c) {
+      start -= (*c)->width;
+      input.push_back(input_item{*c, start, true});
+    }
+  }
+};
+
+
+template<typename table_type, typename token_t>
+const typename incremental_parser<table_type, token_t>::node_type*
+incremental_parser<table_type, token_t>::reparse(std::size_t begin,
+                                                 std::size_t end,
+                                                 const std::vector<token_type>& tokens) {
+  // The nodes built by this parse, and the old nodes it broke down or dropped:
+  std::vector<node_type*> created, discarded;
+  std::size_t reused_count(0);
+
+  std::vector<input_item> input;
+  if (root)
+    push_children(input, input_item{root, 0, true});
+  bool inserted(false);
+
+  std::vector<std::size_t> state_stack;
+  state_stack.reserve(initial_parse_stack_capacity);
+  state_stack.push_back(0);
+
+  reparse_output output{std::vector<node_type*>(), created};
+  std::vector<node_type*>& node_stack(output.node_stack);
+  node_stack.reserve(initial_parse_stack_capacity);
+
+  while (state_stack.back() != table.accepting_state()) {
+    if (not inserted and (input.empty() or input.back().start >= begin)) {
+      for (auto t(tokens.rbegin()); t != tokens.rend(); ++t) {
+        created.push_back(new node_type(*t));
+        input.push_back(input_item{created.back(), begin, false});
+      }
+      inserted = true;
+      continue;
+    }
+    if (input.empty())
+      break;
+
+    const input_item item(input.back());
+    node_type* const n(item.node);
+
+    if (item.old) {
+      const bool edited(n->is_terminal()
+                        ? item.start >= begin and item.start < end
+                        : not (item.start + n->width < begin or item.start >= end));
+      if (n->width == 0 or edited) {
+        input.pop_back();
+        discarded.push_back(n);
+        push_children(input, item);
+        continue;
+      }
+
+      if (not n->is_terminal() and n->state == state_stack.back()) {
+        input.pop_back();
+        node_stack.push_back(n);
+        state_stack.push_back(table.goto_state(state_stack.back(), n->lhs));
+        ++reused_count;
+        continue;
+      }
+    }
+
+    std::size_t terminal_id(0);
+    const node_type* const lookahead(first_terminal(n));
+    if (not table.find_terminal(lookahead->symbol, terminal_id)) {
+      delete_nodes(created);
+      throw std::string("parse error near ") + lookahead->token.render_coordinates();
+    }
+
+    const action_type action(table.action(state_stack.back(), terminal_id));
+
+    if (action.kind == action_type::shift) {
+      input.pop_back();
+      if (not n->is_terminal()) {
+        // A subtree pushed in another state:
+        discarded.push_back(n);
+        push_children(input, item);
+        continue;
+      }
+
+      node_type* leaf(n);
+      if (item.old and n->state == state_stack.back()) {
+        ++reused_count;
+      } else if (item.old) {
+        discarded.push_back(n);
+        created.push_back(leaf = new node_type(n->token));
+      }
+      leaf->state = state_stack.back();
+
+      node_stack.push_back(leaf);
+      state_stack.push_back(action.target);
+    } else if (action.kind == action_type::reduce) {
+      reduce_parse_stacks(table, action, state_stack, output, lookahead->token);
+    } else {
+      const std::vector<symbol_type> expected_symbols(expected_terminals(table, state_stack.back()));
+      const token_type unexpected(lookahead->token);
+      delete_nodes(created);
+      throw parse_error<token_type>(unexpected.copy(), expected_symbols);
+    }
+  }
+
+  // The old tokens after the end of input token are the edited ones:
+  while (not input.empty() and input.back().old
+         and input.back().start + input.back().node->width <= end) {
+    const input_item item(input.back());
+    input.pop_back();
+    discarded.push_back(item.node);
+    push_children(input, item);
+  }
+
+  if (state_stack.back() != table.accepting_state() or not input.empty()) {
+    delete_nodes(created);
+    throw std::string("incremental_parser::reparse() - The input does not end with the end of input token.");
+  }
+
+  // The root is the start rule, with the end of input token:
+  node_type* new_root(new node_type(start, 0, 0, 0));
+  new_root->children = node_stack;
+  for (auto c: new_root->children)
+    new_root->width += c->width;
+
+  if (root)
+    discarded.push_back(root);
+  delete_nodes(discarded);
+  root = new_root;
+  reused = reused_count;
+  return root;
+}
+
+#endif /* _INCREMENTAL_PARSER_H_ */
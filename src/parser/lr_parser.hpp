@@ -11,8 +11,14 @@
 #include <algorithm>
 #include <iomanip>
 #include <queue>
+#include <unordered_map>
+#include <functional>
 
 #include "cf_grammar.hpp"
+#include "digraph.hpp"
+#include "lr_table_file.hpp"
+#include "symbol_traits.hpp"
+#include "../utils/bit_set.hpp"
 
 
 
@@ -65,6 +71,91 @@ inline bool operator==(const parser_item& op1, const parser_item& op2) {
 typedef std::set<parser_item> parser_state_type;
 
 
+/**
+ * \brief Dense numbering of the parser items of a grammar
+ *
+ * The items of a production rule are numbered consecutively, by position of
+ * the dot, and the productions follow each other in the order of
+ * \c cf_grammar::production_rules. The item ids are thus ordered like the
+ * parser items themselves, and the item following \c (p, i) has id
+ * \c id(p, i) + 1.
+ *
+ * The index also caches, for each item, the id of the symbol after the dot,
+ * and for each non terminal symbol, the closure of the items of its
+ * production rules with the dot in first position.
+ */
+class parser_item_index {
+public:
+  enum : unsigned int { no_symbol = static_cast<unsigned int>(-1) };
+
+  parser_item_index(): offsets(1, 0), items(), next_symbols(), closures() {}
+
+  template<typename symbol_type>
+  explicit parser_item_index(const cf_grammar<symbol_type>& grammar);
+
+  std::size_t size() const { return items.size(); }
+
+  unsigned int id(const parser_item& item) const {
+    return offsets[item.production_id] + item.parser_position;
+  }
+  const parser_item& item(unsigned int id) const { return items[id]; }
+
+  // True if the dot of the item is after the last symbol of its production:
+  bool is_complete(unsigned int id) const { return next_symbols[id] == no_symbol; }
+
+  // Id of the symbol after the dot of the item, or no_symbol:
+  unsigned int next_symbol(unsigned int id) const { return next_symbols[id]; }
+
+  // Closure of the items (p, 0), for the production rules p of the symbol:
+  const bit_set& closure(unsigned int symbol_id) const { return closures[symbol_id]; }
+
+private:
+  // offsets[p] is the id of the item (p, 0), offsets.back() is the item count:
+  std::vector<unsigned int> offsets;
+  std::vector<parser_item> items;
+  std::vector<unsigned int> next_symbols;
+  std::vector<bit_set> closures;
+};
+
+template<typename symbol_type>
+parser_item_index::parser_item_index(const cf_grammar<symbol_type>& grammar)
+  : offsets(1, 0), items(), next_symbols(), closures() {
+  const std::vector<std::vector<unsigned int>>& rhs(grammar.production_rhs_ids);
+
+  for (unsigned int i(0); i < rhs.size(); ++i) {
+    for (unsigned int j(0); j <= rhs[i].size(); ++j) {
+      items.push_back(parser_item(i, j));
+      next_symbols.push_back(j < rhs[i].size() ? rhs[i][j] : no_symbol);
+    }
+    offsets.push_back(items.size());
+  }
+
+  // closure(A) is the union of the items (p, 0) of the rules p of A, and of
+  // closure(B) for each rule of A whose right hand side starts with the non
+  // terminal B:
+  std::vector<std::vector<unsigned int>> starts_with(grammar.symbol_set.size());
+  closures.assign(grammar.symbol_set.size(), bit_set(items.size()));
+  for (unsigned int i(0); i < rhs.size(); ++i) {
+    const unsigned int lhs(grammar.production_lhs_ids[i]);
+    closures[lhs].set(offsets[i]);
+    if (rhs[i].size() and not grammar.is_terminal_id(rhs[i].front()))
+      starts_with[lhs].push_back(rhs[i].front());
+  }
+  digraph(starts_with, closures);
+}
+
+
+/**
+ * \brief Compact configuration state of a LR parser
+ *
+ * The same set of parser items as \c parser_state_type, represented as a bit
+ * set over the item ids of a \c parser_item_index. This is the representation
+ * used while the automaton is built: set operations, comparisons and hashing
+ * work a word at a time, and states do not allocate one node per item.
+ */
+typedef bit_set compact_parser_state_type;
+
+
 template<typename symbol_type>
 void print(std::ostream& stream,
            const parser_item& item,
@@ -96,6 +187,17 @@ void print(std::ostream& stream,
 }
 
 
+/**
+ * \brief Method used to compute the lookahead set of the reduce actions
+ *
+ * Both methods share the same LR(0) automaton, hence the same number of states.
+ * \c slr reduces a rule on every terminal of the FOLLOW set of its left hand
+ * side. \c lalr computes the exact LALR(1) lookahead of each reduction, which
+ * accepts more grammars without shift-reduce or reduce-reduce conflict.
+ */
+enum class lookahead_method { slr, lalr };
+
+
 /**
  * \brief Representation of the LR parser associated to a CF grammar
  * 
@@ -105,10 +207,24 @@ void print(std::ostream& stream,
  */
 template<typename symbol_type>
 class lr_parser {
+  typedef std::map<std::pair<unsigned int, unsigned int>, bit_set> lookahead_map_type;
+
   void build_configuration_set(const cf_grammar<symbol_type>& grammar);
-  void build_transition_table(const cf_grammar<symbol_type>& grammar);
-  void build_first_sets(const cf_grammar<symbol_type>& grammar);
-  void build_follow_sets(const cf_grammar<symbol_type>& grammar);
+  void build_transition_table(const cf_grammar<symbol_type>& grammar, lookahead_method method);
+  void build_lalr_lookaheads(const cf_grammar<symbol_type>& grammar,
+                             lookahead_map_type& lookaheads);
+  void set_reduce_action(unsigned int state, unsigned int terminal_id,
+                         unsigned int production_id);
+  void build_nullable_set(const cf_grammar<symbol_type>& grammar);
+  void build_first_sets(const cf_grammar<symbol_type>& grammar,
+                        std::vector<bit_set>& first);
+  void build_follow_sets(const cf_grammar<symbol_type>& grammar,
+                         const std::vector<bit_set>& first);
+
+  void build_symbol_indices();
+
+  // Empty parser, filled by load():
+  lr_parser();
 
 public:
   /** 
@@ -121,6 +237,9 @@ public:
    */
   std::vector<parser_state_type> configuration_set;
 
+  // Numbering of the parser items, which defines the compact parser states:
+  parser_item_index item_index;
+
   /**
    * \brief The state transition map
    *
@@ -128,7 +247,7 @@ public:
    * \c transitionTable[i][s] is the next state if the current state is \c i, and the next symbol on the
    * input is \c s.
    */
-  std::vector<std::vector<short int>> transitions_table;
+  std::vector<std::vector<int>> transitions_table;
 
   /**
    * \brief The goto state map
@@ -136,7 +255,7 @@ public:
    * The goto state map associate to the couple (\c ParserState, \c Symbol) the state to be pushed on the
    * stack once the production rule has been reduced to \c Symbol.
    */
-  std::vector<std::vector<short int>> goto_table;
+  std::vector<std::vector<int>> goto_table;
 
   /**
    * \brief The state which reduce the start production rule.
@@ -155,19 +274,55 @@ public:
   std::map<symbol_type, unsigned int> non_terminal_map;
   std::map<symbol_type, unsigned int> terminal_map;
 
+  // The same information for the parse functions: the column of each
+  // terminal, and the goto column of the lhs of each grammar rule:
+  symbol_index<symbol_type> terminal_index;
+  std::vector<unsigned int> reduce_columns;
+
+  // And the reverse maps, the symbol of each column:
+  std::vector<symbol_type> terminal_symbols;
+  std::vector<symbol_type> non_terminal_symbols;
+
   // First and follow sets for each symbol. As with the \c configurationSet, these members are only used
   // during the constuction of the transitions and goto tables. They could be moved away, but they are
   // convenient for debuging purpose.
   std::map<symbol_type, std::set<symbol_type>> firsts;
   std::map<symbol_type, std::set<symbol_type>> follows;
+
+  // The symbols which derive the empty string, and the same information
+  // indexed by the symbol ids of the grammar:
+  std::set<symbol_type> nullables;
+  std::vector<bool> nullable_symbols;
   
   /**
    * \brief Build a LRParser from a context free grammar \c g.
    *
    * Several steps take place in order to build a functional left-right parser.
    * First of all, the
+   *
+   * The lookahead of the reduce actions is computed with \c method, SLR by
+   * default. A \c std::string is thrown if the grammar has a conflict for this
+   * method.
+   */
+  lr_parser(const cf_grammar<symbol_type>& g,
+            lookahead_method method = lookahead_method::slr);
+
+  /**
+   * \brief Write the parse tables to \c stream, see lr_table_file.hpp.
+   *
+   * Only the data used by the parse functions is stored. The configuration
+   * set and the first and follow sets are not.
    */
-  lr_parser(const cf_grammar<symbol_type>& g);
+  void save(std::ostream& stream, const cf_grammar<symbol_type>& grammar) const;
+
+  /**
+   * \brief Read the parse tables written by \c save.
+   *
+   * The tables must have been built from \c grammar, otherwise a
+   * \c std::string is thrown. The returned parser can be used by the parse
+   * functions, but it has no configuration set, nor first and follow sets.
+   */
+  static lr_parser load(std::istream& stream, const cf_grammar<symbol_type>& grammar);
 
   void print(std::ostream& stream, const cf_grammar<symbol_type>& grammar);
   void print_follow_sets(std::ostream& stream);
@@ -184,25 +339,19 @@ public:
    */
   static void close_parser_state(parser_state_type& p,
                                  const cf_grammar<symbol_type>& grammar);
+  static void close_parser_state(compact_parser_state_type& p,
+                                 const cf_grammar<symbol_type>& grammar,
+                                 const parser_item_index& index);
 
   // Find the successor state S(p, terminal)
   static parser_state_type compute_successor_parser_state(const parser_state_type& state,
                                                           const cf_grammar<symbol_type>& grammar,
                                                           const symbol_type& terminal);
-
-  /**
-   * \brief Check if p is a reducible state.
-   *
-   * A reducible state is a state is a ParserState which has exactly one
-   * ParserItem whose dot is in the last position.
-   *
-   * If more than one ParserItem has a dot in the last position, we are facing a
-   * reduce-reduce conflict, since one cannot choose whose rule to reduce without
-   * looking at the following symbols on the input.
-   */
-  static bool is_reducible(const parser_state_type& p, 
-                           const cf_grammar<symbol_type>& grammar,
-                           unsigned int& production_id);
+  static compact_parser_state_type
+  compute_successor_parser_state(const compact_parser_state_type& state,
+                                 const cf_grammar<symbol_type>& grammar,
+                                 const parser_item_index& index,
+                                 const symbol_type& terminal);
 
   /**
    * \brief Find the rule id which produce the symbol \c s.
@@ -220,8 +369,10 @@ void print(std::ostream& stream,
 
 
 template<typename symbol_type>
-lr_parser<symbol_type>::lr_parser(const cf_grammar<symbol_type>& g):
+lr_parser<symbol_type>::lr_parser(const cf_grammar<symbol_type>& g,
+                                  lookahead_method method):
   configuration_set(),
+  item_index(g),
   transitions_table(),
   goto_table(),
   accepting_state(0),
@@ -229,8 +380,14 @@ lr_parser<symbol_type>::lr_parser(const cf_grammar<symbol_type>& g):
   reduce_symbol(g.production_rules.size(), symbol_type()),
   non_terminal_map(),
   terminal_map(),
+  terminal_index(),
+  reduce_columns(),
+  terminal_symbols(),
+  non_terminal_symbols(),
   firsts(),
-  follows() {
+  follows(),
+  nullables(),
+  nullable_symbols() {
   for (unsigned int i(0); i < rule_lengths.size(); ++i) {
     rule_lengths[i] = g.production_rules[i].second.size();
     reduce_symbol[i] = g.production_rules[i].first;
@@ -242,10 +399,30 @@ lr_parser<symbol_type>::lr_parser(const cf_grammar<symbol_type>& g):
   for (unsigned int i(0); i < g.non_terminals.size(); ++i)
     non_terminal_map[g.non_terminals[i]] = i;    
 
-  build_first_sets(g);
-  build_follow_sets(g);
+  std::vector<bit_set> first_sets;
+  build_nullable_set(g);
+  build_first_sets(g, first_sets);
+  build_follow_sets(g, first_sets);
   build_configuration_set(g);
-  build_transition_table(g);
+  build_transition_table(g, method);
+  build_symbol_indices();
+}
+
+template<typename symbol_type>
+void lr_parser<symbol_type>::build_symbol_indices() {
+  terminal_index = symbol_index<symbol_type>(terminal_map);
+
+  reduce_columns.clear();
+  for (const auto& s: reduce_symbol)
+    reduce_columns.push_back(non_terminal_map.at(s));
+
+  terminal_symbols.resize(terminal_map.size());
+  for (const auto& item: terminal_map)
+    terminal_symbols[item.second] = item.first;
+
+  non_terminal_symbols.resize(non_terminal_map.size());
+  for (const auto& item: non_terminal_map)
+    non_terminal_symbols[item.second] = item.first;
 }
 
 template<typename symbol_type>
@@ -256,6 +433,8 @@ void lr_parser<symbol_type>::print_first_sets(std::ostream& stream) {
     for (typename std::set<symbol_type>::iterator sym(first_set->second.begin());
          sym != first_set->second.end(); ++sym)
       stream << *sym << " ";
+    if (nullables.count(first_set->first))
+      stream << "<empty> ";
     stream << "}" << std::endl;
   }
 }
@@ -286,6 +465,142 @@ void lr_parser<symbol_type>::print_configuration_set(std::ostream& stream,
   }
 }
 
+template<typename symbol_type>
+lr_parser<symbol_type>::lr_parser():
+  configuration_set(),
+  item_index(),
+  transitions_table(),
+  goto_table(),
+  accepting_state(0),
+  rule_lengths(),
+  reduce_symbol(),
+  non_terminal_map(),
+  terminal_map(),
+  terminal_index(),
+  reduce_columns(),
+  terminal_symbols(),
+  non_terminal_symbols(),
+  firsts(),
+  follows(),
+  nullables(),
+  nullable_symbols() {}
+
+template<typename symbol_type>
+void lr_parser<symbol_type>::save(std::ostream& stream,
+                                  const cf_grammar<symbol_type>& grammar) const {
+  lr_table_file_header header = {
+    lr_table_file_header::magic_number,
+    lr_table_file_header::current_version,
+    lr_table_file_header::byte_order_mark,
+    sizeof(symbol_type),
+    grammar.fingerprint(),
+    static_cast<std::uint32_t>(transitions_table.size()),
+    static_cast<std::uint32_t>(terminal_map.size()),
+    static_cast<std::uint32_t>(non_terminal_map.size()),
+    static_cast<std::uint32_t>(rule_lengths.size()),
+    static_cast<std::uint32_t>(accepting_state),
+    0
+  };
+  const lr_table_file_layout layout(header);
+
+  std::vector<std::int32_t> actions, gotos;
+  for (std::size_t i(0); i < transitions_table.size(); ++i) {
+    actions.insert(actions.end(), transitions_table[i].begin(), transitions_table[i].end());
+    gotos.insert(gotos.end(), goto_table[i].begin(), goto_table[i].end());
+  }
+
+  std::vector<std::uint32_t> lengths(rule_lengths.begin(), rule_lengths.end()), lhs;
+  for (const auto& s: reduce_symbol)
+    lhs.push_back(non_terminal_map.at(s));
+
+  // The maps are sorted by symbol:
+  std::vector<std::uint32_t> terminal_order;
+  std::vector<symbol_type> terminals(terminal_map.size()), non_terminals(non_terminal_map.size());
+  for (const auto& item: terminal_map) {
+    terminal_order.push_back(item.second);
+    terminals[item.second] = item.first;
+  }
+  for (const auto& item: non_terminal_map)
+    non_terminals[item.second] = item.first;
+
+  const char padding[8] = {0};
+  stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  stream.write(reinterpret_cast<const char*>(actions.data()), actions.size() * sizeof(std::int32_t));
+  stream.write(reinterpret_cast<const char*>(gotos.data()), gotos.size() * sizeof(std::int32_t));
+  stream.write(reinterpret_cast<const char*>(lengths.data()), lengths.size() * sizeof(std::uint32_t));
+  stream.write(reinterpret_cast<const char*>(lhs.data()), lhs.size() * sizeof(std::uint32_t));
+  stream.write(reinterpret_cast<const char*>(terminal_order.data()),
+               terminal_order.size() * sizeof(std::uint32_t));
+  stream.write(padding, layout.terminals - (layout.terminal_order + terminal_order.size() * sizeof(std::uint32_t)));
+  stream.write(reinterpret_cast<const char*>(terminals.data()), terminals.size() * sizeof(symbol_type));
+  stream.write(reinterpret_cast<const char*>(non_terminals.data()), non_terminals.size() * sizeof(symbol_type));
+  stream.write(padding, layout.size - (layout.non_terminals + non_terminals.size() * sizeof(symbol_type)));
+
+  if (not stream)
+    throw std::string("lr_parser::save() - Unable to write the tables.");
+}
+
+template<typename symbol_type>
+lr_parser<symbol_type> lr_parser<symbol_type>::load(std::istream& stream,
+                                                    const cf_grammar<symbol_type>& grammar) {
+  lr_table_file_header header;
+  if (not stream.read(reinterpret_cast<char*>(&header), sizeof(header)))
+    throw std::string("lr_parser::load() - Unable to read the table file header.");
+  header.check(grammar.fingerprint(), sizeof(symbol_type));
+
+  const lr_table_file_layout layout(header);
+  std::vector<char> data(layout.size - sizeof(header));
+  if (not stream.read(data.data(), data.size()))
+    throw std::string("lr_parser::load() - The table file is truncated.");
+
+  auto array = [&](std::size_t offset) {
+    return data.data() + offset - sizeof(header);
+  };
+  auto read_uint32 = [&](std::size_t offset, std::size_t i) {
+    std::uint32_t value(0);
+    std::copy_n(array(offset) + i * sizeof(value), sizeof(value), reinterpret_cast<char*>(&value));
+    return value;
+  };
+  auto read_int32 = [&](std::size_t offset, std::size_t i) {
+    std::int32_t value(0);
+    std::copy_n(array(offset) + i * sizeof(value), sizeof(value), reinterpret_cast<char*>(&value));
+    return value;
+  };
+  auto read_symbol = [&](std::size_t offset, std::size_t i) {
+    symbol_type value;
+    std::copy_n(array(offset) + i * sizeof(value), sizeof(value), reinterpret_cast<char*>(&value));
+    return value;
+  };
+
+  lr_parser p;
+  p.accepting_state = header.accepting_state;
+
+  p.transitions_table.assign(header.states, std::vector<int>(header.terminals, 0));
+  p.goto_table.assign(header.states, std::vector<int>(header.non_terminals, 0));
+  for (std::size_t i(0); i < header.states; ++i) {
+    for (std::size_t j(0); j < header.terminals; ++j)
+      p.transitions_table[i][j] = read_int32(layout.actions, i * header.terminals + j);
+    for (std::size_t j(0); j < header.non_terminals; ++j)
+      p.goto_table[i][j] = read_int32(layout.gotos, i * header.non_terminals + j);
+  }
+
+  for (std::size_t i(0); i < header.terminals; ++i)
+    p.terminal_map[read_symbol(layout.terminals, i)] = i;
+  for (std::size_t i(0); i < header.non_terminals; ++i)
+    p.non_terminal_map[read_symbol(layout.non_terminals, i)] = i;
+
+  for (std::size_t i(0); i < header.productions; ++i) {
+    const std::uint32_t lhs(read_uint32(layout.rule_lhs, i));
+    if (lhs >= header.non_terminals)
+      throw std::string("lr_parser::load() - The table file is corrupted.");
+    p.rule_lengths.push_back(read_uint32(layout.rule_lengths, i));
+    p.reduce_symbol.push_back(read_symbol(layout.non_terminals, lhs));
+  }
+  p.build_symbol_indices();
+
+  return p;
+}
+
 template<typename symbol_type>
 void lr_parser<symbol_type>::print(std::ostream& stream,
                                    const cf_grammar<symbol_type>& grammar) {
@@ -347,178 +662,348 @@ void lr_parser<symbol_type>::print(std::ostream& stream,
 }
 
 
+// Compute the nullable symbols, which derive the empty string. Each
+// production counts the symbols of its right hand side not yet known to be
+// nullable, and each newly nullable symbol decrements the count of the
+// productions where it occurs. This is linear in the size of the grammar.
+template<typename symbol_type>
+void lr_parser<symbol_type>::build_nullable_set(const cf_grammar<symbol_type>& grammar) {
+  const std::vector<std::vector<unsigned int>>& rhs(grammar.production_rhs_ids);
+
+  nullable_symbols.assign(grammar.symbol_set.size(), false);
+  nullables.clear();
+
+  std::vector<unsigned int> pending(rhs.size(), 0);
+  std::vector<std::vector<unsigned int>> occurrences(grammar.symbol_set.size());
+  std::vector<unsigned int> visit_list;
+
+  const auto set_nullable([&](unsigned int production_id) {
+      const unsigned int lhs(grammar.production_lhs_ids[production_id]);
+      if (not nullable_symbols[lhs]) {
+        nullable_symbols[lhs] = true;
+        visit_list.push_back(lhs);
+      }
+    });
+
+  for (unsigned int i(0); i < rhs.size(); ++i) {
+    pending[i] = rhs[i].size();
+    for (const auto symbol: rhs[i])
+      occurrences[symbol].push_back(i);
+    if (pending[i] == 0)
+      set_nullable(i);
+  }
+
+  while (not visit_list.empty()) {
+    const unsigned int symbol(visit_list.back());
+    visit_list.pop_back();
+    nullables.insert(grammar.symbol_set[symbol]);
+
+    for (const auto production_id: occurrences[symbol])
+      if (--pending[production_id] == 0)
+        set_nullable(production_id);
+  }
+}
+
 // Compute the first set of each grammar symbol:
 // DragonBook pp221.
-// We assume no epsilon production, here.
+// FIRST(A) includes FIRST(X) for each rule A -> a X b where a is nullable.
+// These inclusions are solved with the digraph algorithm, on bit sets over
+// the terminal indices.
 template<typename symbol_type>
-void lr_parser<symbol_type>::build_first_sets(const cf_grammar<symbol_type>& grammar) {
-  /*
-   * Le first set des terminaux est trivial: c'est eux-meme:
-   */
-  for (unsigned int i(0); i < grammar.terminals.size(); ++i)
-    firsts[grammar.terminals[i]].insert(grammar.terminals[i]);
-
-  bool stop(false);
-  while (not stop) {
-    std::map<symbol_type, std::set<symbol_type>> firstsp(firsts);
-
-    /*
-     * Pour chaque non terminal:
-     */
-    for (unsigned int i(0); i < grammar.production_rules.size(); ++i) {
-      const symbol_list_type<symbol_type>& rhs(grammar.production_rules[i].second);
-      const symbol_type lhs(grammar.production_rules[i].first);
-
-      firsts[lhs].insert(firstsp[rhs.front()].begin(),
-                         firstsp[rhs.front()].end());
+void lr_parser<symbol_type>::build_first_sets(const cf_grammar<symbol_type>& grammar,
+                                              std::vector<bit_set>& first) {
+  const std::vector<std::vector<unsigned int>>& rhs(grammar.production_rhs_ids);
+
+  first.assign(grammar.symbol_set.size(), bit_set(grammar.terminals.size()));
+  std::vector<std::vector<unsigned int>> includes(grammar.symbol_set.size());
+
+  // The first set of a terminal is the terminal itself:
+  for (unsigned int i(0); i < grammar.symbol_set.size(); ++i)
+    if (grammar.is_terminal_id(i))
+      first[i].set(grammar.symbol_indices[i]);
+
+  for (unsigned int i(0); i < rhs.size(); ++i)
+    for (const auto symbol: rhs[i]) {
+      includes[grammar.production_lhs_ids[i]].push_back(symbol);
+      if (not nullable_symbols[symbol])
+        break;
     }
-    stop = (firsts == firstsp);
+
+  digraph(includes, first);
+
+  firsts.clear();
+  for (unsigned int i(0); i < grammar.symbol_set.size(); ++i) {
+    std::set<symbol_type>& first_set(firsts[grammar.symbol_set[i]]);
+    first[i].for_each([&](std::size_t t) { first_set.insert(grammar.terminals[t]); });
   }
 }
 
 // Compute the follow set of a grammar symbol
 // dragonBook pp222.
+// For each rule A -> a B b, FOLLOW(B) includes FIRST(b), and FOLLOW(A) if b
+// is nullable. The right hand side is walked backward, so that FIRST(b) is
+// accumulated along the way, and the inclusions between follow sets are
+// solved with the digraph algorithm.
 template<typename symbol_type>
-void lr_parser<symbol_type>::build_follow_sets(const cf_grammar<symbol_type>& grammar) {
-  bool stop(false);
-  while (not stop) {
-    const std::map<symbol_type, std::set<symbol_type>> followsp(follows);
-
-    /*
-     * Pour tous les symbols non-terminaux:
-     */ 
-    for (unsigned int i(0); i < grammar.non_terminals.size(); ++i) {
-      symbol_type current(grammar.non_terminals[i]);
-
-      /*
-       * Je regard si ce symbol (non-terminal) apparait dans le rhs d'une production:
-       * NOTE: Il ne _SUFFIT PAS_ de trouver la premiere occurence!
-       */
-      for (unsigned int j(0); j < grammar.production_rules.size(); ++j) {
-        const symbol_list_type<symbol_type>& rhs(grammar.production_rules[j].second);
-
-        typename symbol_list_type<symbol_type>::const_iterator it(rhs.begin());
-        while ((it = std::find(it, rhs.end(), current)) != rhs.end()) {
-          //if((it = std::find(rhs.begin(), rhs.end(), current)) != rhs.end())
-          /*
-           * Si le symbol est trouve dans le rhs:
-           */
-          const symbol_type lhs(grammar.production_rules[j].first);
-
-          if(++it != rhs.end()) {
-            follows[current].insert(firsts[*it].begin(),
-                                    firsts[*it].end());
-	  } else {
-	    const auto lhs_item(followsp.find(lhs));
-	    if (lhs_item != followsp.end())
-	      follows[current].insert(lhs_item->second.begin(),
-				      lhs_item->second.end());
-	  }
-        }
+void lr_parser<symbol_type>::build_follow_sets(const cf_grammar<symbol_type>& grammar,
+                                               const std::vector<bit_set>& first) {
+  const std::vector<std::vector<unsigned int>>& rhs(grammar.production_rhs_ids);
+
+  std::vector<bit_set> follow(grammar.symbol_set.size(), bit_set(grammar.terminals.size()));
+  std::vector<std::vector<unsigned int>> includes(grammar.symbol_set.size());
+  std::vector<bool> occurs(grammar.symbol_set.size(), false);
+
+  for (unsigned int i(0); i < rhs.size(); ++i) {
+    const unsigned int lhs(grammar.production_lhs_ids[i]);
+    bit_set trailer(grammar.terminals.size());
+    bool trailer_nullable(true);
+
+    for (unsigned int j(rhs[i].size()); j-- > 0;) {
+      const unsigned int symbol(rhs[i][j]);
+      if (not grammar.is_terminal_id(symbol)) {
+        occurs[symbol] = true;
+        follow[symbol] |= trailer;
+        if (trailer_nullable)
+          includes[symbol].push_back(lhs);
+      }
+
+      if (nullable_symbols[symbol]) {
+        trailer |= first[symbol];
+      } else {
+        trailer = first[symbol];
+        trailer_nullable = false;
       }
     }
-    stop = (follows == followsp);
   }
+
+  digraph(includes, follow);
+
+  follows.clear();
+  for (unsigned int i(0); i < grammar.symbol_set.size(); ++i)
+    if (occurs[i]) {
+      std::set<symbol_type>& follow_set(follows[grammar.symbol_set[i]]);
+      follow[i].for_each([&](std::size_t t) { follow_set.insert(grammar.terminals[t]); });
+    }
 }
 
+// Build the LR(0) automaton in a single worklist pass. Each state is
+// identified through a hashed index, and its shift and goto transitions are
+// recorded in the tables as soon as its successors are known. The states are
+// handled in their compact form, and only converted to parser_state_type
+// once the automaton is complete.
 template<typename symbol_type>
 void lr_parser<symbol_type>::build_configuration_set(const cf_grammar<symbol_type>& g) {
-  std::queue<parser_state_type> visit_list;
-  
+  std::vector<compact_parser_state_type> states;
+  std::unordered_map<compact_parser_state_type, unsigned int, bit_set_hash> state_index;
+  std::queue<unsigned int> visit_list;
+
+  // Successor kernels, indexed by symbol id. They are cleared once used:
+  std::vector<compact_parser_state_type> kernels(g.symbol_set.size(),
+                                                 compact_parser_state_type(item_index.size()));
+
+  configuration_set.clear();
+  transitions_table.clear();
+  goto_table.clear();
+
   // build the starting state:
   unsigned int start_production_id(find_production(g, g.start_symbol));
-  visit_list.push(parser_state_type());
-  visit_list.back().insert(parser_item(start_production_id, 0));
-  close_parser_state(visit_list.back(), g);
+  compact_parser_state_type start(item_index.size());
+  start.set(item_index.id(parser_item(start_production_id, 0)));
+  close_parser_state(start, g, item_index);
+
+  state_index.emplace(start, 0);
+  states.push_back(start);
+  visit_list.push(0);
 
   // visit all the successor states:
   while (not visit_list.empty()) {
-    const parser_state_type current(visit_list.front());
+    const unsigned int current(visit_list.front());
     visit_list.pop();
 
-    if(std::find(configuration_set.begin(), 
-                 configuration_set.end(),
-                 current) == configuration_set.end()) {
-      for (unsigned int i(0); i < g.symbol_set.size(); ++i) {
-        const symbol_type& sym(g.symbol_set[i]);
-        parser_state_type succ(compute_successor_parser_state(current, g, sym));
-        if(not succ.empty())
-          visit_list.push(succ);
+    // Group the kernel items of every successor by the symbol they advance
+    // over. The item following the item id is id + 1. The symbols are then
+    // visited by increasing id, that is in the order of the symbols:
+    std::vector<unsigned int> successor_symbols;
+    states[current].for_each([&](std::size_t id) {
+        const unsigned int symbol(item_index.next_symbol(id));
+        if (symbol != parser_item_index::no_symbol) {
+          if (kernels[symbol].none())
+            successor_symbols.push_back(symbol);
+          kernels[symbol].set(id + 1);
+        }
+      });
+    std::sort(successor_symbols.begin(), successor_symbols.end());
+
+    transitions_table.push_back(std::vector<int>(g.terminals.size(), 0));
+    goto_table.push_back(std::vector<int>(g.non_terminals.size(), 0));
+
+    for (const auto symbol: successor_symbols) {
+      compact_parser_state_type& kernel(kernels[symbol]);
+      close_parser_state(kernel, g, item_index);
+
+      const auto inserted(state_index.emplace(kernel, states.size()));
+      if (inserted.second) {
+        states.push_back(kernel);
+        visit_list.push(inserted.first->second);
       }
-      configuration_set.push_back(current);
+      kernel.clear();
+
+      const unsigned int successor_id(inserted.first->second);
+      if (g.is_terminal_id(symbol))
+        transitions_table[current][g.symbol_indices[symbol]] = successor_id + 1;
+      else
+        goto_table[current][g.symbol_indices[symbol]] = successor_id + 1;
     }
   }
+
+  configuration_set.resize(states.size());
+  for (unsigned int i(0); i < states.size(); ++i)
+    states[i].for_each([&](std::size_t id) {
+        configuration_set[i].insert(configuration_set[i].end(), item_index.item(id));
+      });
 }
 
-// Build the transition and the goto tables:
+// Complete the transition table with the reduce actions. The shift and goto
+// entries have already been filled by build_configuration_set.
 template<typename symbol_type>
-void lr_parser<symbol_type>::build_transition_table(const cf_grammar<symbol_type>& grammar) {
-  transitions_table.clear();
-  transitions_table.resize(configuration_set.size(),
-                           std::vector<short int>(grammar.terminals.size(), 0));
-
-  goto_table.clear();
-  goto_table.resize(configuration_set.size(),
-                    std::vector<short int>(grammar.non_terminals.size(), 0));
+void lr_parser<symbol_type>::build_transition_table(const cf_grammar<symbol_type>& grammar,
+                                                    lookahead_method method) {
+  const std::vector<production_type<symbol_type>>& g(grammar.production_rules);
 
-  // Fill each line of the transition and goto tables:
-  for (unsigned int i(0); i < configuration_set.size(); ++i) {
-    // Fill each column of the transition table:
-    //   0: syntax error, 
-    // > 0: shift and push,
-    // < 0: reduce and pop.
-    unsigned int grammar_production_id(0);
-    if(is_reducible(configuration_set[i], grammar, grammar_production_id)) {// reduce:
-      if(grammar.production_rules[grammar_production_id].first == grammar.start_symbol) {
-        accepting_state = i;
-      } else {
-        symbol_type reduced_symbol(grammar.production_rules[grammar_production_id].first);
-        const std::set<symbol_type>& follow(follows[reduced_symbol]);
-        for (typename std::set<symbol_type>::const_iterator term(follow.begin());
-            term != follow.end();
-            ++term) {
-          transitions_table[ i ][ terminal_map[*term] ] = - grammar_production_id - 1;
+  lookahead_map_type lookaheads;
+  if (method == lookahead_method::lalr)
+    build_lalr_lookaheads(grammar, lookaheads);
+
+  // Fill each line of the transition table:
+  //   0: syntax error,
+  // > 0: shift and push,
+  // < 0: reduce and pop.
+  for (unsigned int i(0); i < configuration_set.size(); ++i)
+    for (const auto& item: configuration_set[i])
+      if (item.parser_position == g[item.production_id].second.size()) {
+        const symbol_type& reduced_symbol(g[item.production_id].first);
+        if (reduced_symbol == grammar.start_symbol) {
+          accepting_state = i;
+        } else if (method == lookahead_method::slr) {
+          const std::set<symbol_type>& follow(follows[reduced_symbol]);
+          for (typename std::set<symbol_type>::const_iterator term(follow.begin());
+               term != follow.end();
+               ++term)
+            set_reduce_action(i, terminal_map[*term], item.production_id);
+        } else {
+          lookaheads[std::make_pair(i, item.production_id)]
+            .for_each([&](std::size_t t) { set_reduce_action(i, t, item.production_id); });
         }
       }
-    }
-      
-    for (unsigned int j(0); j < grammar.terminals.size(); ++j) {  // shift
-      // compute the successor
-      parser_state_type succ(compute_successor_parser_state(configuration_set[i],
-                                                            grammar,
-                                                            grammar.terminals[j]));
-      if(succ.size()) {
-        // find the id of succ in the configuration set:
-        std::vector<parser_state_type>::iterator 
-          successor_it(std::find(configuration_set.begin(),
-                                 configuration_set.end(),
-                                 succ));
-        unsigned int successor_id(std::distance(configuration_set.begin(),
-                                                successor_it));
-        if(transitions_table[i][j] == 0)
-          transitions_table[i][j] = successor_id + 1;
-        else
-          throw std::string("LRParser::buildTransitionTable()"
-                            " - A shift-reduce conflict is found.");
+}
+
+template<typename symbol_type>
+void lr_parser<symbol_type>::set_reduce_action(unsigned int state,
+                                               unsigned int terminal_id,
+                                               unsigned int production_id) {
+  int& entry(transitions_table[state][terminal_id]);
+  const int reduce(- production_id - 1);
+
+  if (entry == 0)
+    entry = reduce;
+  else if (entry > 0)
+    throw std::string("LRParser::buildTransitionTable()"
+                      " - A shift-reduce conflict is found.");
+  else if (entry != reduce)
+    throw std::string("LRParser::buildTransitionTable()"
+                      " - A reduce-reduce conflict is found.");
+}
+
+// Compute the LALR(1) lookahead set of each (state, completed production) pair,
+// following DeRemer and Pennello, Efficient Computation of LALR(1) Look-Ahead
+// Sets (1982). Every nonterminal transition (p, A) of the LR(0) automaton gets
+// a set Follow(p, A), computed from:
+//   - DR(p, A), the terminals shifted from goto(p, A),
+//   - the relation (p, A) reads (r, C) iff r = goto(p, A), C is nullable and
+//     goto(r, C) is defined, which gives Read(p, A),
+//   - the relation (p, A) includes (p', B) iff B -> b A c, c derives the empty
+//     string and p' reaches p by reading b.
+// The lookahead of the reduction of A -> w in state q is then the union of
+// the Follow(p, A) such that p reaches q by reading w (the lookback relation).
+//
+// This has to be called before the reduce actions are added to the transition
+// table.
+template<typename symbol_type>
+void lr_parser<symbol_type>::build_lalr_lookaheads(const cf_grammar<symbol_type>& grammar,
+                                                   lookahead_map_type& lookaheads) {
+  // Number the nonterminal transitions of the automaton:
+  std::vector<std::vector<int>> transition_id(goto_table.size(),
+                                              std::vector<int>(grammar.non_terminals.size(), -1));
+  std::vector<std::pair<unsigned int, unsigned int>> transitions;
+  for (unsigned int p(0); p < goto_table.size(); ++p)
+    for (unsigned int a(0); a < goto_table[p].size(); ++a)
+      if (goto_table[p][a] != 0) {
+        transition_id[p][a] = transitions.size();
+        transitions.push_back(std::make_pair(p, a));
       }
-    }
-      
-    // Fill each line of the goto table:
-    for (unsigned int j(0); j < grammar.non_terminals.size(); ++j) {
-      parser_state_type succ(compute_successor_parser_state(configuration_set[i],
-                                                            grammar,
-                                                            grammar.non_terminals[j]));
-      if(succ.size()) {
-        std::vector<parser_state_type>::iterator
-          successor_it(std::find(configuration_set.begin(),
-                                 configuration_set.end(),
-                                 succ));
-        unsigned int successor_id(std::distance(configuration_set.begin(),
-                                                successor_it));
-        goto_table[i][j] = successor_id + 1;
+
+  // Direct reads:
+  std::vector<bit_set> follow(transitions.size(), bit_set(grammar.terminals.size()));
+  for (unsigned int i(0); i < transitions.size(); ++i) {
+    const unsigned int r(goto_table[transitions[i].first][transitions[i].second] - 1);
+    for (unsigned int t(0); t < transitions_table[r].size(); ++t)
+      if (transitions_table[r][t] > 0)
+        follow[i].set(t);
+  }
+
+  // Reads, through the nullable non terminals:
+  std::vector<bool> nullable_columns(grammar.non_terminals.size(), false);
+  for (unsigned int a(0); a < grammar.non_terminals.size(); ++a)
+    nullable_columns[a] = nullable_symbols[grammar.symbol_id(grammar.non_terminals[a])];
+
+  std::vector<std::vector<unsigned int>> reads(transitions.size());
+  for (unsigned int i(0); i < transitions.size(); ++i) {
+    const unsigned int r(goto_table[transitions[i].first][transitions[i].second] - 1);
+    for (unsigned int c(0); c < goto_table[r].size(); ++c)
+      if (goto_table[r][c] != 0 and nullable_columns[c])
+        reads[i].push_back(transition_id[r][c]);
+  }
+
+  digraph(reads, follow);
+
+  // Walk each production from each state which has a transition on its left
+  // hand side, to build the includes and lookback relations:
+  std::vector<std::vector<unsigned int>> includes(transitions.size());
+  std::map<std::pair<unsigned int, unsigned int>, std::vector<unsigned int>> lookback;
+  for (unsigned int i(0); i < transitions.size(); ++i) {
+    const unsigned int lhs(grammar.symbol_id(grammar.non_terminals[transitions[i].second]));
+
+    for (auto k(grammar.lhs_productions_begin(lhs)); k != grammar.lhs_productions_end(lhs); ++k) {
+      const std::vector<unsigned int>& rhs(grammar.production_rhs_ids[*k]);
+
+      // nullable_suffix[j] is true if the symbols from j + 1 are all nullable:
+      std::vector<bool> nullable_suffix(rhs.size(), true);
+      for (unsigned int j(rhs.size()); j-- > 1;)
+        nullable_suffix[j - 1] = nullable_suffix[j] and nullable_symbols[rhs[j]];
+
+      unsigned int q(transitions[i].first);
+      for (unsigned int j(0); j < rhs.size(); ++j) {
+        const unsigned int column(grammar.symbol_indices[rhs[j]]);
+        if (not grammar.is_terminal_id(rhs[j])) {
+          if (nullable_suffix[j])
+            includes[transition_id[q][column]].push_back(i);
+          q = goto_table[q][column] - 1;
+        } else {
+          q = transitions_table[q][column] - 1;
+        }
       }
+      lookback[std::make_pair(q, *k)].push_back(i);
     }
   }
+
+  digraph(includes, follow);
+
+  for (const auto& item: lookback) {
+    bit_set& lookahead(lookaheads[item.first]);
+    lookahead.resize(grammar.terminals.size());
+    for (const auto i: item.second)
+      lookahead |= follow[i];
+  }
 }
 
 // Complete the partial parser state
@@ -536,18 +1021,32 @@ void lr_parser<symbol_type>::close_parser_state(parser_state_type& p, const cf_g
     parser_item current(visit_list.top());
     visit_list.pop();
 
-    if(std::find(p.begin(), p.end(), current) == p.end()) {
-      if(current.parser_position < g[current.production_id].second.size() 
-         and grammar.is_non_terminal(g[current.production_id].second[current.parser_position])) {
-        for (unsigned int i(0); i < g.size(); ++i)
-          if(g[i].first == g[current.production_id].second[current.parser_position])
-            visit_list.push(parser_item(i, 0));
+    if(p.find(current) == p.end()) {
+      if(current.parser_position < g[current.production_id].second.size()) {
+        const unsigned int symbol(grammar.production_rhs_ids[current.production_id][current.parser_position]);
+        for (auto i(grammar.lhs_productions_begin(symbol)); i != grammar.lhs_productions_end(symbol); ++i)
+          visit_list.push(parser_item(*i, 0));
       }
       p.insert(current);
     }
   }
 }
 
+// Complete the partial compact parser state: the closure of a state is the
+// union of its items and of the cached closures of the non terminals found
+// after a dot. The closure items are iterated over as they are added, which
+// is harmless since their own closure is already included.
+template<typename symbol_type>
+void lr_parser<symbol_type>::close_parser_state(compact_parser_state_type& p,
+                                                const cf_grammar<symbol_type>& grammar,
+                                                const parser_item_index& index) {
+  p.for_each([&](std::size_t id) {
+      const unsigned int symbol(index.next_symbol(id));
+      if (symbol != parser_item_index::no_symbol and not grammar.is_terminal_id(symbol))
+        p |= index.closure(symbol);
+    });
+}
+
 // Find the production rule for the non terminal symbol s in the grammar g
 // (what if there is more than one?)
 // THIS IS UNSAFE! ONLY USE TO FIND THE START SYMBOL, WHICH SHOULD BE UNIQUE!
@@ -598,26 +1097,22 @@ parser_state_type lr_parser<symbol_type>::compute_successor_parser_state(const p
   return succ;
 }
 
+// Find the compact successor state S(p, terminal)
 template<typename symbol_type>
-bool lr_parser<symbol_type>::is_reducible(const parser_state_type& p,
-                             const cf_grammar<symbol_type>& grammar,
-                             unsigned int& production_id) {
-  const std::vector<production_type<symbol_type>>& g(grammar.production_rules);
-
-  bool found(false);
-  for (parser_state_type::const_iterator item(p.begin()); item != p.end(); ++item)
-    if(item->parser_position == g[item->production_id].second.size()) {
-      if(not found) {
-        production_id = item->production_id;
-        found = true;
-      } else {
-          throw std::string("isReducible()"
-                            "- A reduce-reduce conflict is found.");
-      }
-    }
-  return found;
+compact_parser_state_type
+lr_parser<symbol_type>::compute_successor_parser_state(const compact_parser_state_type& state,
+                                                       const cf_grammar<symbol_type>& grammar,
+                                                       const parser_item_index& index,
+                                                       const symbol_type& terminal) {
+  const unsigned int symbol(grammar.symbol_id(terminal));
+  compact_parser_state_type succ(index.size());
+  state.for_each([&](std::size_t id) {
+      if(index.next_symbol(id) == symbol)
+        succ.set(id + 1);
+    });
+
+  close_parser_state(succ, grammar, index);
+  return succ;
 }
 
-
-
 #endif /* _LR_PARSER_H_ */
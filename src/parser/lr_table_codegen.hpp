@@ -0,0 +1,197 @@
+#ifndef _LR_TABLE_CODEGEN_H_
+#define _LR_TABLE_CODEGEN_H_
+
+#include <cctype>
+#include <cstdint>
+#include <string>
+#include <initializer_list>
+#include <algorithm>
+#include <map>
+#include <vector>
+#include <iostream>
+#include <type_traits>
+
+#include "lr_parser.hpp"
+#include "symbol_traits.hpp"
+
+
+/**
+ * \brief Write the values of [begin, end) as the body of a C++ array initializer.
+ */
+template<typename iterator_type, typename writer_type>
+void write_array_values(std::ostream& stream,
+                        iterator_type begin,
+                        iterator_type end,
+                        writer_type write_value) {
+  std::size_t count(0);
+  for (iterator_type it(begin); it != end; ++it, ++count) {
+    stream << (count % 12 == 0 ? "\n    " : " ");
+    write_value(stream, *it);
+    stream << ",";
+  }
+  stream << "\n  ";
+}
+
+namespace codegen_detail {
+  // Enumerations are written as a cast of their underlying value, other
+  // symbols as they are streamed.
+  template<typename symbol_type>
+  void write_symbol(std::ostream& stream, const std::string& type_name,
+                    const symbol_type& s, std::true_type) {
+    stream << "static_cast<" << type_name << ">("
+           << static_cast<typename std::underlying_type<symbol_type>::type>(s) << ")";
+  }
+
+  template<typename symbol_type>
+  void write_symbol(std::ostream& stream, const std::string&,
+                    const symbol_type& s, std::false_type) {
+    stream << s;
+  }
+
+  // Column + 1 of each terminal by symbol_traits::index, if the symbols have
+  // a dense numbering which fits an array (see dense_columns):
+  template<typename symbol_type>
+  std::vector<std::uint32_t> terminal_columns(const std::map<symbol_type, unsigned int>&, std::false_type) {
+    return std::vector<std::uint32_t>();
+  }
+
+  template<typename symbol_type>
+  std::vector<std::uint32_t> terminal_columns(const std::map<symbol_type, unsigned int>& terminal_map,
+                                              std::true_type) {
+    return dense_columns(terminal_map);
+  }
+}
+
+
+/**
+ * \brief Write the tables of \c parser as \c constexpr arrays in a C++ header.
+ *
+ * The generated header defines the class \c name, whose static members hold
+ * the parse tables in the layout of a table file (see lr_table_file.hpp):
+ * \code{.cpp}
+ * struct name {
+ *   typedef symbol_type_name symbol_type;
+ *   static constexpr std::size_t state_count, terminal_count, non_terminal_count,
+ *                                production_count, accepting_state;
+ *   static constexpr std::int32_t actions[], gotos[];
+ *   static constexpr std::uint32_t rule_lengths[], rule_lhs[], terminal_order[];
+ *   static constexpr symbol_type terminals[], non_terminals[];
+ *   static constexpr std::size_t terminal_column_count;
+ *   static constexpr std::uint32_t terminal_columns[];
+ * };
+ * \endcode
+ * \c terminal_columns holds the column + 1 of the terminals by their
+ * symbol_traits index, or 0. It is empty, and \c terminal_column_count is 0,
+ * if the symbols are not densely numbered.
+ * The class is a template instance, so that the header can be included in
+ * several translation units. The symbol type must be declared before the
+ * generated header is included. Use it with the parse functions through
+ * \c static_lr_table<name>.
+ *
+ * \param write_symbol Function (std::ostream&, const symbol_type&) writing the
+ *        C++ expression of a symbol.
+ */
+template<typename symbol_type, typename writer_type>
+void write_lr_tables(std::ostream& stream,
+                     const lr_parser<symbol_type>& parser,
+                     const std::string& name,
+                     const std::string& symbol_type_name,
+                     writer_type write_symbol) {
+  const std::size_t states(parser.transitions_table.size());
+
+  std::vector<int> actions, gotos;
+  for (std::size_t i(0); i < states; ++i) {
+    actions.insert(actions.end(), parser.transitions_table[i].begin(), parser.transitions_table[i].end());
+    gotos.insert(gotos.end(), parser.goto_table[i].begin(), parser.goto_table[i].end());
+  }
+
+  std::vector<unsigned int> lhs, terminal_order;
+  for (const auto& s: parser.reduce_symbol)
+    lhs.push_back(parser.non_terminal_map.at(s));
+
+  std::vector<symbol_type> terminals(parser.terminal_map.size()),
+    non_terminals(parser.non_terminal_map.size());
+  for (const auto& item: parser.terminal_map) {
+    terminal_order.push_back(item.second);
+    terminals[item.second] = item.first;
+  }
+  for (const auto& item: parser.non_terminal_map)
+    non_terminals[item.second] = item.first;
+
+  std::vector<std::uint32_t> columns(codegen_detail::terminal_columns(parser.terminal_map,
+                                                                     std::integral_constant<bool, symbol_traits<symbol_type>::is_dense>()));
+
+  auto write_integer = [](std::ostream& s, long long value) { s << value; };
+  const std::string instance(name + "_tables");
+  std::string guard(name);
+  for (auto& c: guard)
+    c = std::toupper(static_cast<unsigned char>(c));
+
+  stream << "// Parse tables generated by write_lr_tables(). Do not edit.\n"
+         << "#ifndef _" << guard << "_TABLES_H_\n"
+         << "#define _" << guard << "_TABLES_H_\n\n"
+         << "#include <cstddef>\n"
+         << "#include <cstdint>\n\n"
+         << "template<typename = void>\n"
+         << "struct " << instance << " {\n"
+         << "  typedef " << symbol_type_name << " symbol_type;\n\n"
+         << "  static constexpr std::size_t state_count = " << states << ";\n"
+         << "  static constexpr std::size_t terminal_count = " << terminals.size() << ";\n"
+         << "  static constexpr std::size_t non_terminal_count = " << non_terminals.size() << ";\n"
+         << "  static constexpr std::size_t production_count = " << lhs.size() << ";\n"
+         << "  static constexpr std::size_t accepting_state = " << parser.accepting_state << ";\n"
+         << "  static constexpr std::size_t terminal_column_count = " << columns.size() << ";\n\n";
+
+  stream << "  static constexpr std::int32_t actions[] = {";
+  write_array_values(stream, actions.begin(), actions.end(), write_integer);
+  stream << "};\n  static constexpr std::int32_t gotos[] = {";
+  write_array_values(stream, gotos.begin(), gotos.end(), write_integer);
+  stream << "};\n  static constexpr std::uint32_t rule_lengths[] = {";
+  write_array_values(stream, parser.rule_lengths.begin(), parser.rule_lengths.end(), write_integer);
+  stream << "};\n  static constexpr std::uint32_t rule_lhs[] = {";
+  write_array_values(stream, lhs.begin(), lhs.end(), write_integer);
+  stream << "};\n  static constexpr std::uint32_t terminal_order[] = {";
+  write_array_values(stream, terminal_order.begin(), terminal_order.end(), write_integer);
+  stream << "};\n  static constexpr symbol_type terminals[] = {";
+  write_array_values(stream, terminals.begin(), terminals.end(), write_symbol);
+  stream << "};\n  static constexpr symbol_type non_terminals[] = {";
+  write_array_values(stream, non_terminals.begin(), non_terminals.end(), write_symbol);
+  stream << "};\n  static constexpr std::uint32_t terminal_columns[] = {";
+  // An array cannot be empty:
+  if (columns.empty())
+    columns.push_back(0);
+  write_array_values(stream, columns.begin(), columns.end(), write_integer);
+  stream << "};\n};\n\n";
+
+  // Definitions of the static members, which are odr-used by the parse functions:
+  auto define = [&](const std::string& type, std::initializer_list<const char*> members) {
+    for (const auto member: members)
+      stream << "template<typename T> constexpr " << type << " "
+             << instance << "<T>::" << member << ";\n";
+  };
+  define("std::size_t", {"state_count", "terminal_count", "non_terminal_count",
+                         "production_count", "accepting_state", "terminal_column_count"});
+  define("std::int32_t", {"actions[]", "gotos[]"});
+  define("std::uint32_t", {"rule_lengths[]", "rule_lhs[]", "terminal_order[]", "terminal_columns[]"});
+  define("typename " + instance + "<T>::symbol_type", {"terminals[]", "non_terminals[]"});
+  stream << "\ntypedef " << instance << "<> " << name << ";\n\n"
+         << "#endif\n";
+}
+
+/**
+ * \brief Write the tables of \c parser, whose symbols are enumerations or
+ * integers, as \c constexpr arrays in a C++ header.
+ */
+template<typename symbol_type>
+void write_lr_tables(std::ostream& stream,
+                     const lr_parser<symbol_type>& parser,
+                     const std::string& name,
+                     const std::string& symbol_type_name) {
+  write_lr_tables(stream, parser, name, symbol_type_name,
+                  [&symbol_type_name](std::ostream& s, const symbol_type& symbol) {
+                    codegen_detail::write_symbol(s, symbol_type_name, symbol,
+                                                 std::is_enum<symbol_type>());
+                  });
+}
+
+#endif /* _LR_TABLE_CODEGEN_H_ */
@@ -0,0 +1,95 @@
+#ifndef _LR_TABLE_FILE_H_
+#define _LR_TABLE_FILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+
+/**
+ * \brief Header of a binary file of LR parse tables
+ *
+ * The header is followed by the arrays:
+ * \code
+ * std::int32_t actions[states * terminals];        // as lr_parser::transitions_table
+ * std::int32_t gotos[states * non_terminals];      // as lr_parser::goto_table
+ * std::uint32_t rule_lengths[productions];
+ * std::uint32_t rule_lhs[productions];             // goto column of the lhs
+ * std::uint32_t terminal_order[terminals];         // columns, sorted by symbol
+ * symbol_type terminals[terminals];                // by column
+ * symbol_type non_terminals[non_terminals];        // by column
+ * \endcode
+ * The symbol arrays and the end of the file are aligned on 8 bytes, so that a
+ * file mapped in memory can be used in place, see mapped_lr_table.hpp.
+ *
+ * The values are stored in the byte order of the machine, and the symbols as
+ * their binary representation. A file written by a machine with another byte
+ * order, or by a program with another symbol size, is rejected, as well as a
+ * file built from another grammar, as identified by cf_grammar::fingerprint.
+ */
+struct lr_table_file_header {
+  enum : std::uint32_t {
+    magic_number = 0x4254524c, // "LRTB"
+    current_version = 1,
+    byte_order_mark = 0x01020304
+  };
+
+  std::uint32_t magic;
+  std::uint32_t version;
+  std::uint32_t byte_order;
+  std::uint32_t symbol_size;
+  std::uint64_t fingerprint;
+
+  std::uint32_t states;
+  std::uint32_t terminals;
+  std::uint32_t non_terminals;
+  std::uint32_t productions;
+  std::uint32_t accepting_state;
+  std::uint32_t reserved;
+
+  /**
+   * \brief Throw a \c std::string if the header does not describe tables of
+   * the grammar with \c expected_fingerprint, stored with the current format.
+   */
+  void check(std::uint64_t expected_fingerprint, std::size_t expected_symbol_size) const {
+    if (magic != magic_number)
+      throw std::string("lr_table_file_header::check() - This is not a table file.");
+    if (version != current_version)
+      throw std::string("lr_table_file_header::check() - Unsupported table file version.");
+    if (byte_order != byte_order_mark or symbol_size != expected_symbol_size)
+      throw std::string("lr_table_file_header::check()"
+                        " - The table file was written on an incompatible platform.");
+    if (fingerprint != expected_fingerprint)
+      throw std::string("lr_table_file_header::check()"
+                        " - The table file was built from another grammar.");
+  }
+};
+
+
+/**
+ * \brief Byte offsets of the arrays of a table file
+ */
+struct lr_table_file_layout {
+  std::size_t actions;
+  std::size_t gotos;
+  std::size_t rule_lengths;
+  std::size_t rule_lhs;
+  std::size_t terminal_order;
+  std::size_t terminals;
+  std::size_t non_terminals;
+  std::size_t size;
+
+  explicit lr_table_file_layout(const lr_table_file_header& h)
+    : actions(sizeof(lr_table_file_header)),
+      gotos(actions + sizeof(std::int32_t) * h.states * h.terminals),
+      rule_lengths(gotos + sizeof(std::int32_t) * h.states * h.non_terminals),
+      rule_lhs(rule_lengths + sizeof(std::uint32_t) * h.productions),
+      terminal_order(rule_lhs + sizeof(std::uint32_t) * h.productions),
+      terminals(align(terminal_order + sizeof(std::uint32_t) * h.terminals)),
+      non_terminals(terminals + h.symbol_size * h.terminals),
+      size(align(non_terminals + h.symbol_size * h.non_terminals)) {}
+
+  static std::size_t align(std::size_t offset) { return (offset + 7) & ~std::size_t(7); }
+};
+
+#endif /* _LR_TABLE_FILE_H_ */
@@ -0,0 +1,151 @@
+#ifndef _MAPPED_LR_TABLE_H_
+#define _MAPPED_LR_TABLE_H_
+
+#include <cstdint>
+#include <string>
+#include <algorithm>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "cf_grammar.hpp"
+#include "lr_table_file.hpp"
+#include "packed_lr_table.hpp"
+
+
+/**
+ * \brief Parse tables used in place from a read-only mapping of a table file
+ *
+ * The file is written by lr_parser::save. Nothing is copied at load time:
+ * the pages of the file are shared by all the processes which map it.
+ *
+ * This class provides the table interface of the parse functions, see
+ * packed_lr_table.hpp.
+ */
+template<typename symbol_t>
+class mapped_lr_table {
+public:
+  typedef symbol_t symbol_type;
+  typedef std::uint32_t index_type;
+  typedef lr_action<index_type> action_type;
+
+  static_assert(std::is_trivially_copyable<symbol_type>::value and alignof(symbol_type) <= 8,
+                "The symbols of a table file are stored as their binary representation.");
+
+  /**
+   * \brief Map the table file \c filename, built from \c grammar.
+   *
+   * A \c std::string is thrown if the file cannot be mapped, or if it does not
+   * contain the tables of \c grammar.
+   */
+  mapped_lr_table(const std::string& filename, const cf_grammar<symbol_type>& grammar);
+  ~mapped_lr_table() { munmap(const_cast<char*>(data), size); }
+
+  mapped_lr_table(const mapped_lr_table&) = delete;
+  mapped_lr_table& operator=(const mapped_lr_table&) = delete;
+
+  std::size_t state_count() const { return header().states; }
+  std::size_t terminal_count() const { return header().terminals; }
+  std::size_t non_terminal_count() const { return header().non_terminals; }
+
+  std::size_t accepting_state() const { return header().accepting_state; }
+
+  bool find_terminal(const symbol_type& s, std::size_t& column) const {
+    const std::uint32_t* begin(terminal_order);
+    const std::uint32_t* end(terminal_order + header().terminals);
+    const std::uint32_t* item(std::lower_bound(begin, end, s, [&](std::uint32_t c, const symbol_type& value) {
+          return terminals[c] < value;
+        }));
+    if (item == end or s < terminals[*item])
+      return false;
+    column = *item;
+    return true;
+  }
+
+  action_type action(std::size_t state, std::size_t column) const {
+    const std::int32_t entry(actions[state * header().terminals + column]);
+    if (entry > 0)
+      return action_type{action_type::shift, static_cast<index_type>(entry - 1), 0, 0};
+    if (entry < 0) {
+      const std::size_t production_id(- entry - 1);
+      return action_type{action_type::reduce,
+                         static_cast<index_type>(production_id),
+                         rule_lengths[production_id],
+                         rule_lhs[production_id]};
+    }
+    return action_type{action_type::error, 0, 0, 0};
+  }
+
+  std::size_t goto_state(std::size_t state, std::size_t column) const {
+    const std::int32_t entry(gotos[state * header().non_terminals + column]);
+    return entry > 0 ? entry - 1 : 0;
+  }
+
+  const symbol_type& terminal(std::size_t column) const { return terminals[column]; }
+  const symbol_type& non_terminal(std::size_t column) const { return non_terminals[column]; }
+
+private:
+  const char* data;
+  std::size_t size;
+
+  const std::int32_t* actions;
+  const std::int32_t* gotos;
+  const std::uint32_t* rule_lengths;
+  const std::uint32_t* rule_lhs;
+  const std::uint32_t* terminal_order;
+  const symbol_type* terminals;
+  const symbol_type* non_terminals;
+
+  const lr_table_file_header& header() const {
+    return *reinterpret_cast<const lr_table_file_header*>(data);
+  }
+};
+
+
+template<typename symbol_t>
+mapped_lr_table<symbol_t>::mapped_lr_table(const std::string& filename,
+                                           const cf_grammar<symbol_type>& grammar)
+  : data(nullptr), size(0), actions(nullptr), gotos(nullptr), rule_lengths(nullptr),
+    rule_lhs(nullptr), terminal_order(nullptr), terminals(nullptr), non_terminals(nullptr) {
+  const int fd(open(filename.c_str(), O_RDONLY));
+  if (fd < 0)
+    throw std::string("mapped_lr_table::mapped_lr_table() - Unable to open ") + filename;
+
+  struct stat status;
+  if (fstat(fd, &status) != 0 or static_cast<std::size_t>(status.st_size) < sizeof(lr_table_file_header)) {
+    close(fd);
+    throw std::string("mapped_lr_table::mapped_lr_table() - Unable to read the table file header.");
+  }
+
+  size = status.st_size;
+  void* mapping(mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0));
+  close(fd);
+  if (mapping == MAP_FAILED)
+    throw std::string("mapped_lr_table::mapped_lr_table() - Unable to map ") + filename;
+  data = static_cast<const char*>(mapping);
+
+  try {
+    header().check(grammar.fingerprint(), sizeof(symbol_type));
+
+    const lr_table_file_layout layout(header());
+    if (layout.size > size)
+      throw std::string("mapped_lr_table::mapped_lr_table() - The table file is truncated.");
+
+    actions = reinterpret_cast<const std::int32_t*>(data + layout.actions);
+    gotos = reinterpret_cast<const std::int32_t*>(data + layout.gotos);
+    rule_lengths = reinterpret_cast<const std::uint32_t*>(data + layout.rule_lengths);
+    rule_lhs = reinterpret_cast<const std::uint32_t*>(data + layout.rule_lhs);
+    terminal_order = reinterpret_cast<const std::uint32_t*>(data + layout.terminal_order);
+    terminals = reinterpret_cast<const symbol_type*>(data + layout.terminals);
+    non_terminals = reinterpret_cast<const symbol_type*>(data + layout.non_terminals);
+  }
+  catch (...) {
+    munmap(mapping, size);
+    throw;
+  }
+}
+
+#endif /* _MAPPED_LR_TABLE_H_ */
@@ -0,0 +1,171 @@
+#ifndef _PACKED_LR_TABLE_H_
+#define _PACKED_LR_TABLE_H_
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+#include <map>
+
+#include "lr_parser.hpp"
+
+
+/**
+ * \brief Action returned by the \c action() function of the table types
+ *
+ * A reduce action carries everything the parse drivers need to perform the
+ * reduction: the production id, the number of states to pop, and the goto
+ * column of the reduced symbol. No other lookup is needed. The tables do not
+ * store this structure, they decode it from a single value per entry.
+ */
+template<typename index_type>
+struct lr_action {
+  enum kind_type: unsigned char { error = 0, shift, reduce };
+
+  kind_type kind;
+
+  // shift: the state to push. reduce: the production id.
+  index_type target;
+
+  // reduce only: the length of the right hand side of the production,
+  // and the column of its left hand side in the goto table.
+  index_type length;
+  index_type lhs;
+};
+
+
+/**
+ * \brief Contiguous copy of the tables of a \c lr_parser
+ *
+ * The action and goto tables are each stored as a single row-major array,
+ * with one row per state. An action entry is a single value, as in
+ * \c compressed_lr_table: the length and the left hand side of a reduced
+ * production are read from the rule arrays when the action is decoded. The
+ * width of the stored values is \c index_t, \c std::uint16_t by default.
+ * Use \c std::uint32_t when the number of states plus the number of
+ * productions exceeds 65535.
+ *
+ * This class, as the other table types, is used through the following
+ * interface by the table driven parse functions of parse_input.hpp:
+ * \code{.cpp}
+ * std::size_t accepting_state() const;
+ * bool find_terminal(const symbol_type& s, std::size_t& column) const;
+ * action_type action(std::size_t state, std::size_t column) const;
+ * std::size_t goto_state(std::size_t state, std::size_t column) const;
+ * const symbol_type& terminal(std::size_t column) const;
+ * const symbol_type& non_terminal(std::size_t column) const;
+ * \endcode
+ */
+template<typename symbol_t, typename index_t = std::uint16_t>
+class packed_lr_table {
+public:
+  typedef symbol_t symbol_type;
+  typedef index_t index_type;
+  typedef lr_action<index_type> action_type;
+
+  explicit packed_lr_table(const lr_parser<symbol_type>& parser);
+
+  std::size_t state_count() const { return states; }
+  std::size_t terminal_count() const { return terminals.size(); }
+  std::size_t non_terminal_count() const { return non_terminals.size(); }
+
+  std::size_t accepting_state() const { return accepting; }
+
+  /**
+   * \brief Find the action table column of the terminal symbol \c s.
+   *
+   * Returns false if \c s is not a terminal of the grammar.
+   */
+  bool find_terminal(const symbol_type& s, std::size_t& column) const {
+    return terminal_index.find(s, column);
+  }
+
+  action_type action(std::size_t state, std::size_t column) const {
+    const index_type value(actions[state * terminals.size() + column]);
+    if (value == 0)
+      return action_type{action_type::error, 0, 0, 0};
+    if (value <= states)
+      return action_type{action_type::shift, static_cast<index_type>(value - 1), 0, 0};
+
+    const std::size_t production_id(value - states - 1);
+    return action_type{action_type::reduce,
+                       static_cast<index_type>(production_id),
+                       rule_lengths[production_id],
+                       rule_lhs[production_id]};
+  }
+
+  /**
+   * \brief State to push after a reduction to the non terminal of \c column.
+   *
+   * The initial state is never the target of a transition, so 0 denotes an
+   * empty entry.
+   */
+  std::size_t goto_state(std::size_t state, std::size_t column) const {
+    return gotos[state * non_terminals.size() + column];
+  }
+
+  const symbol_type& terminal(std::size_t column) const { return terminals[column]; }
+  const symbol_type& non_terminal(std::size_t column) const { return non_terminals[column]; }
+
+private:
+  std::size_t states;
+  std::size_t accepting;
+
+  // Actions values are encoded as: 0 for an error, state + 1 for a shift,
+  // and state_count() + production id + 1 for a reduction.
+  std::vector<index_type> actions;
+  std::vector<index_type> gotos;
+
+  std::vector<index_type> rule_lengths;
+  std::vector<index_type> rule_lhs;
+
+  std::vector<symbol_type> terminals;
+  std::vector<symbol_type> non_terminals;
+  symbol_index<symbol_type> terminal_index;
+
+  static index_type narrow(std::size_t value) {
+    if (value > std::numeric_limits<index_type>::max())
+      throw std::string("packed_lr_table::packed_lr_table()"
+                        " - The parser does not fit in the index type.");
+    return static_cast<index_type>(value);
+  }
+};
+
+
+template<typename symbol_t, typename index_t>
+packed_lr_table<symbol_t, index_t>::packed_lr_table(const lr_parser<symbol_type>& parser)
+  : states(parser.transitions_table.size()),
+    accepting(parser.accepting_state),
+    actions(),
+    gotos(),
+    rule_lengths(parser.rule_lengths.size(), 0),
+    rule_lhs(parser.rule_lengths.size(), 0),
+    terminals(parser.terminal_map.size()),
+    non_terminals(parser.non_terminal_map.size()),
+    terminal_index(parser.terminal_index) {
+  narrow(states + rule_lengths.size() + 1);
+
+  for (const auto& item: parser.terminal_map)
+    terminals[item.second] = item.first;
+  narrow(terminals.size());
+  for (const auto& item: parser.non_terminal_map)
+    non_terminals[item.second] = item.first;
+
+  for (std::size_t i(0); i < rule_lengths.size(); ++i) {
+    rule_lengths[i] = narrow(parser.rule_lengths[i]);
+    rule_lhs[i] = narrow(parser.reduce_columns[i]);
+  }
+
+  actions.reserve(states * terminals.size());
+  gotos.reserve(states * non_terminals.size());
+
+  for (std::size_t i(0); i < states; ++i) {
+    for (const int entry: parser.transitions_table[i])
+      actions.push_back(static_cast<index_type>(entry >= 0 ? entry : states - entry));
+
+    for (const int entry: parser.goto_table[i])
+      gotos.push_back(entry > 0 ? narrow(entry - 1) : 0);
+  }
+}
+
+#endif /* _PACKED_LR_TABLE_H_ */
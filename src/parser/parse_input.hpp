@@ -2,8 +2,14 @@
 #define PARSE_INPUT_H
 
 #include <list>
+#include <type_traits>
+#include <vector>
 
 #include "lr_parser.hpp"
+#include "packed_lr_table.hpp"
+#include "compressed_lr_table.hpp"
+#include "flat_tree.hpp"
+#include "semantic_actions.hpp"
 
 
 template<typename token_type>
@@ -37,93 +43,430 @@ void pop(std::list<T>& list, unsigned int n) {
   list.erase(lower_bound.base(), list.end());
 }
 
-template<class token_source_type, typename tree_factory_type>
-typename tree_factory_type::node_type*
-parse_input_to_tree(lr_parser<typename token_source_type::symbol_type>& parser,
-                    token_source_type& input,
-                    tree_factory_type& tree_factory) {
-  using token_type = typename token_source_type::token_type;
-  using symbol_type = typename token_type::symbol_type;
+template<class T>
+void pop(std::vector<T>& stack, std::size_t n) {
+  stack.resize(stack.size() - n);
+}
+
+/*
+ * The parse stacks are contiguous: a shift is a push_back into reserved
+ * storage and a reduction only moves the end of the stack. The children of a
+ * reduced node are passed to tree_factory_type::build_node as the pointer
+ * range [begin, end) into the node stack, valid during the call only.
+ */
+const std::size_t initial_parse_stack_capacity(64);
+
+/*
+ * Release a node which is not part of the tree: the factory does it if it
+ * owns its nodes, otherwise the node is deleted.
+ */
+template<typename tree_factory_type, typename node_type>
+auto release_node(tree_factory_type& tree_factory, node_type* n, int)
+  -> decltype(tree_factory.release(n), void()) {
+  tree_factory.release(n);
+}
+
+template<typename tree_factory_type, typename node_type>
+void release_node(tree_factory_type&, node_type* n, long) {
+  delete n;
+}
+
+template<typename table_type>
+std::vector<typename table_type::symbol_type>
+expected_terminals(const table_type& table, std::size_t state) {
+  std::vector<typename table_type::symbol_type> expected_symbols;
+  for (std::size_t i(0); i < table.terminal_count(); ++i)
+    if (table.action(state, i).kind != table_type::action_type::error)
+      expected_symbols.push_back(table.terminal(i));
+  return expected_symbols;
+}
+
+
+/*
+ * Output policies of parse_input_to_output. An output keeps the stack of
+ * the symbols of the parse, which parallels the state stack, and builds the
+ * result of the parse from it:
+ *
+ *   template<typename token_source_type>
+ *   void shift(token_source_type& input);
+ *   template<typename action_type, typename symbol_type, typename token_type>
+ *   void reduce(const action_type& action, const symbol_type& lhs,
+ *               std::size_t state, const token_type& next);
+ *
+ * shift() pushes the symbol of the current token of input. reduce() replaces
+ * the action.length symbols on top of the stack by lhs: action is the reduce
+ * action, state the state uncovered by the reduction and next the lookahead.
+ * If throws_parse_error is true, a syntax error throws parse_error, otherwise
+ * the parse returns false.
+ */
+
+/*
+ * Output of parse_input_to_tree: the nodes are built by the tree factory.
+ * The nodes left on the stack when the parse fails are released.
+ */
+template<typename tree_factory_type>
+class tree_output {
+public:
   using node_type = typename tree_factory_type::node_type;
 
-  std::list<node_type*> node_stack;
+  static const bool throws_parse_error = true;
+
+  explicit tree_output(tree_factory_type& tree_factory)
+    : node_stack(), tree_factory(tree_factory) {
+    node_stack.reserve(initial_parse_stack_capacity);
+  }
+
+  ~tree_output() { clear(); }
+
+  tree_output(const tree_output&) = delete;
+  tree_output& operator=(const tree_output&) = delete;
+
+  template<typename token_source_type>
+  void shift(token_source_type& input) {
+    node_stack.push_back(tree_factory.build_leaf(input));
+  }
+
+  template<typename action_type, typename symbol_type, typename token_type>
+  void reduce(const action_type& action, const symbol_type& lhs, std::size_t, const token_type&) {
+    node_type** const end(node_stack.data() + node_stack.size());
+    node_type* p(tree_factory.build_node(end - action.length, end, action.target, lhs));
+    pop(node_stack, action.length);
+    node_stack.push_back(p);
+  }
+
+  /**
+   * \brief Take the tree of an accepted input.
+   */
+  node_type* result() {
+    release_node(tree_factory, node_stack.back(), 0); //The start rule is not reduced, hence two symbols are on the stack
+    node_type* root(node_stack.front());
+    node_stack.clear();
+    return root;
+  }
+
+  void clear() {
+    for (auto n: node_stack)
+      release_node(tree_factory, n, 0);
+    node_stack.clear();
+  }
+
+  // The subtrees of the parse, from the bottom of the stack:
+  std::vector<node_type*> node_stack;
+
+private:
+  tree_factory_type& tree_factory;
+};
+
+/*
+ * The flat tree output writes the records of the tree in the caller's
+ * buffer, and keeps the index of the first record of the subtree of each
+ * symbol on the parse stack. The buffer is cleared first, but its capacity
+ * is kept, so that it can be reused across parses without reallocation.
+ * After the parse, the root of the tree is the last record.
+ */
+template<typename symbol_type, typename token_type>
+void shift_flat_tree(std::vector<flat_tree_record<symbol_type> >& records,
+                     std::vector<std::size_t>& subtree_stack,
+                     const token_type& t) {
+  typedef flat_tree_record<symbol_type> record_type;
+
+  subtree_stack.push_back(records.size());
+  records.push_back(record_type{t.symbol, record_type::terminal_id, 0, 1,
+                                flat_tree_detail::token_span(t, 0)});
+}
+
+template<typename symbol_type, typename token_type>
+void reduce_flat_tree(std::vector<flat_tree_record<symbol_type> >& records,
+                      std::vector<std::size_t>& subtree_stack,
+                      std::size_t length,
+                      std::size_t production_id,
+                      const symbol_type& s,
+                      const token_type& next) {
+  lexeme_span span{flat_tree_detail::token_span(next, 0).offset, 0};
+  std::size_t first(records.size());
+  if (length > 0) {
+    first = subtree_stack[subtree_stack.size() - length];
+    span.offset = records[first].span.offset;
+    span.length = records.back().span.offset + records.back().span.length - span.offset;
+  }
+
+  pop(subtree_stack, length);
+  subtree_stack.push_back(records.size());
+  records.push_back(flat_tree_record<symbol_type>{s,
+                                                  static_cast<std::uint32_t>(production_id),
+                                                  static_cast<std::uint32_t>(length),
+                                                  static_cast<std::uint32_t>(records.size() - first + 1),
+                                                  span});
+}
+
+template<typename symbol_t>
+class flat_tree_output {
+public:
+  typedef symbol_t symbol_type;
+
+  static const bool throws_parse_error = true;
+
+  explicit flat_tree_output(std::vector<flat_tree_record<symbol_type> >& records)
+    : records(records), subtree_stack() {
+    records.clear();
+    subtree_stack.reserve(initial_parse_stack_capacity);
+  }
+
+  template<typename token_source_type>
+  void shift(token_source_type& input) {
+    shift_flat_tree(records, subtree_stack, input.get());
+  }
+
+  template<typename action_type, typename token_type>
+  void reduce(const action_type& action, const symbol_type& lhs, std::size_t, const token_type& next) {
+    reduce_flat_tree(records, subtree_stack, action.length, action.target, lhs, next);
+  }
+
+  void finish() {
+    records.pop_back(); //The start rule is not reduced, hence two symbols are on the stack
+  }
+
+private:
+  std::vector<flat_tree_record<symbol_type> >& records;
+  std::vector<std::size_t> subtree_stack;
+};
+
+/*
+ * The value output evaluates the semantic actions during the parse, on a
+ * stack of values: no tree is built, and the memory used is bounded by the
+ * depth of the parse stack. The values are erased rather than resized off
+ * the stack, so that they do not need a default constructor.
+ */
+template<typename value_type, typename token_type>
+class value_output {
+public:
+  static const bool throws_parse_error = true;
+
+  explicit value_output(const semantic_actions<value_type, token_type>& actions)
+    : actions(actions), value_stack() {
+    value_stack.reserve(initial_parse_stack_capacity);
+  }
+
+  template<typename token_source_type>
+  void shift(token_source_type& input) {
+    value_stack.push_back(actions.shift(input.get()));
+  }
+
+  template<typename action_type, typename symbol_type>
+  void reduce(const action_type& action, const symbol_type&, std::size_t, const token_type&) {
+    value_type* const end(value_stack.data() + value_stack.size());
+    value_type v(actions.reduce(action.target, end - action.length, end));
+    value_stack.erase(value_stack.end() - action.length, value_stack.end());
+    value_stack.push_back(std::move(v));
+  }
+
+  // The value of the first symbol of the start rule:
+  value_type result() {
+    return std::move(value_stack.front()); //The start rule is not reduced, hence two symbols are on the stack
+  }
+
+private:
+  const semantic_actions<value_type, token_type>& actions;
+  std::vector<value_type> value_stack;
+};
+
+/*
+ * Output of parse_input, which only recognizes the input.
+ */
+struct no_output {
+  static const bool throws_parse_error = false;
+
+  template<typename token_source_type>
+  void shift(token_source_type&) {}
+
+  template<typename action_type, typename symbol_type, typename token_type>
+  void reduce(const action_type&, const symbol_type&, std::size_t, const token_type&) {}
+};
+
+
+/*
+ * The shift and reduce steps of the parse, shared by all the drivers. The
+ * action is given by the table, and the stacks are updated accordingly.
+ */
+template<typename action_type, typename output_type, typename token_source_type>
+void shift_parse_stacks(const action_type& action,
+                        std::vector<std::size_t>& state_stack,
+                        output_type& output,
+                        token_source_type& input) {
+  output.shift(input);
+  state_stack.push_back(action.target);
+}
+
+template<typename table_type, typename output_type, typename token_type>
+void reduce_parse_stacks(const table_type& table,
+                         const typename table_type::action_type& action,
+                         std::vector<std::size_t>& state_stack,
+                         output_type& output,
+                         const token_type& next) {
+  pop(state_stack, action.length);
+  output.reduce(action, table.non_terminal(action.lhs), state_stack.back(), next);
+  state_stack.push_back(table.goto_state(state_stack.back(), action.lhs));
+}
+
+template<typename table_type, typename token_type>
+bool syntax_error(const table_type&, std::size_t, const token_type&, std::false_type) {
+  return false;
+}
+
+template<typename table_type, typename token_type>
+bool syntax_error(const table_type& table, std::size_t state, const token_type& t, std::true_type) {
+  throw parse_error<token_type>(t.copy(), expected_terminals(table, state));
+}
 
-  std::list<unsigned int> state_stack;
+/*
+ * The parse loop of all the parse functions. The tables are accessed
+ * through the interface documented in packed_lr_table.hpp, so that any table
+ * representation can be used with the same driver, and the symbols are
+ * pushed to output, see the output policies above.
+ */
+template<typename table_type, typename token_source_type, typename output_type>
+bool parse_input_to_output(const table_type& table,
+                           token_source_type& input,
+                           output_type& output) {
+  using action_type = typename table_type::action_type;
+
+  std::vector<std::size_t> state_stack;
+  state_stack.reserve(initial_parse_stack_capacity);
   state_stack.push_back(0);
 
-  while(state_stack.back() != parser.accepting_state) {
-    const auto terminal_map_item(parser.terminal_map.find(input.get().symbol));
-    if (terminal_map_item == parser.terminal_map.end())
+  while(state_stack.back() != table.accepting_state()) {
+    std::size_t terminal_id(0);
+    if (not table.find_terminal(input.get().symbol, terminal_id))
       throw std::string("parse error near ") + input.get().render_coordinates();
-    
-    const unsigned int terminal_id(terminal_map_item->second);
-    const int action(parser.transitions_table[ state_stack.back() ][ terminal_id ]);
 
-    if(action > 0) {  // shift
-      node_stack.push_back(tree_factory.build_leaf(input));
+    const action_type action(table.action(state_stack.back(), terminal_id));
 
-      state_stack.push_back(action - 1);
+    if(action.kind == action_type::shift) {
+      shift_parse_stacks(action, state_stack, output, input);
       input.next();
-    } else if(action < 0) {  // reduce
-      const unsigned int production_rule_id(- action - 1);
-      const unsigned int non_terminal_symbol_id(parser.non_terminal_map[parser.reduce_symbol[production_rule_id]]);
-
-      typename std::list<node_type*>::iterator start(node_stack.end());
-      std::advance(start, - static_cast<int>(parser.rule_lengths[production_rule_id]));
-      node_type* p(tree_factory.build_node(start,
-                                           node_stack.end(),
-                                           production_rule_id,
-                                           parser.reduce_symbol[production_rule_id]));
-      pop(node_stack, parser.rule_lengths[production_rule_id]);
-      node_stack.push_back(p);
-
-      pop(state_stack, parser.rule_lengths[production_rule_id]);
-      state_stack.push_back(parser.goto_table[ state_stack.back() ][ non_terminal_symbol_id ] - 1);
+    } else if(action.kind == action_type::reduce) {
+      reduce_parse_stacks(table, action, state_stack, output, input.get());
     } else {
-      std::map<unsigned int, symbol_type> inverse_symbol_map;
-      for (const auto& item: parser.terminal_map)
-        inverse_symbol_map[item.second] = item.first;
-
-      std::vector<symbol_type> expected_symbols;
-      for (std::size_t i(0); i < parser.transitions_table[ state_stack.back() ].size(); ++i) {
-        if (parser.transitions_table[ state_stack.back() ][i] != 0)
-          expected_symbols.push_back(inverse_symbol_map[i]);
-      }
-      throw parse_error<token_type>(input.get().copy(), expected_symbols);
+      return syntax_error(table, state_stack.back(), input.get(),
+                          std::integral_constant<bool, output_type::throws_parse_error>());
     }
   }
-  delete node_stack.back(); //The start rule is not reduced, hence two symbols are on the stack
-  return node_stack.front();
+  return true;
 }
 
-template<typename token_source_type>
-bool parse_input(lr_parser<typename token_source_type::symbol_type>& parser,
+
+template<class token_source_type, typename tree_factory_type, typename table_type>
+typename tree_factory_type::node_type*
+parse_input_to_tree(const table_type& table,
+                    token_source_type& input,
+                    tree_factory_type& tree_factory) {
+  tree_output<tree_factory_type> output(tree_factory);
+  parse_input_to_output(table, input, output);
+  return output.result();
+}
+
+template<typename token_source_type, typename table_type>
+void parse_input_to_flat_tree(const table_type& table,
+                              token_source_type& input,
+                              std::vector<flat_tree_record<typename token_source_type::symbol_type> >& records) {
+  flat_tree_output<typename token_source_type::symbol_type> output(records);
+  parse_input_to_output(table, input, output);
+  output.finish();
+}
+
+template<typename token_source_type, typename table_type, typename value_type>
+value_type parse_input_to_value(const table_type& table,
+                                token_source_type& input,
+                                const semantic_actions<value_type, typename token_source_type::token_type>& actions) {
+  value_output<value_type, typename token_source_type::token_type> output(actions);
+  parse_input_to_output(table, input, output);
+  return output.result();
+}
+
+template<typename token_source_type, typename table_type>
+bool parse_input(const table_type& table,
                  token_source_type& input) {
-  std::list<unsigned int> state_stack;
-  state_stack.push_back(0);
+  no_output output;
+  return parse_input_to_output(table, input, output);
+}
 
-  while(state_stack.back() != parser.accepting_state) {
-    const auto terminal_map_item(parser.terminal_map.find(input.get().symbol));
-    if (terminal_map_item == parser.terminal_map.end())
-      throw std::string("parse error near ") + input.get().render_coordinates();
-    
-    const unsigned int terminal_id(terminal_map_item->second);
-    const int action(parser.transitions_table[ state_stack.back() ][ terminal_id ]);
 
-    if(action > 0) {  // shift
-      state_stack.push_back(action - 1);
-      input.next();
-    } else if(action < 0) {  // reduce
-      const unsigned int production_rule_id(-action-1);
-      const unsigned int non_terminal_symbol_id(parser.non_terminal_map[parser.reduce_symbol[production_rule_id]]);
+/**
+ * \brief Table interface over the tables of a \c lr_parser
+ *
+ * The parse functions taking a \c lr_parser use it through this adapter,
+ * with the same driver as the other tables.
+ */
+template<typename symbol_t>
+class lr_parser_table {
+public:
+  typedef symbol_t symbol_type;
+  typedef lr_action<unsigned int> action_type;
 
-      pop(state_stack, parser.rule_lengths[production_rule_id]);
-      state_stack.push_back(parser.goto_table[ state_stack.back() ][ non_terminal_symbol_id ] - 1);
-    } else {
-      return false;
+  explicit lr_parser_table(const lr_parser<symbol_type>& parser): parser(parser) {}
+
+  std::size_t terminal_count() const { return parser.terminal_symbols.size(); }
+
+  std::size_t accepting_state() const { return parser.accepting_state; }
+
+  bool find_terminal(const symbol_type& s, std::size_t& column) const {
+    return parser.terminal_index.find(s, column);
+  }
+
+  action_type action(std::size_t state, std::size_t column) const {
+    const int entry(parser.transitions_table[state][column]);
+    if (entry > 0)
+      return action_type{action_type::shift, static_cast<unsigned int>(entry - 1), 0, 0};
+    if (entry < 0) {
+      const unsigned int production_id(- entry - 1);
+      return action_type{action_type::reduce, production_id,
+                         parser.rule_lengths[production_id],
+                         parser.reduce_columns[production_id]};
     }
+    return action_type{action_type::error, 0, 0, 0};
   }
-  return true;
+
+  std::size_t goto_state(std::size_t state, std::size_t column) const {
+    return parser.goto_table[state][column] - 1;
+  }
+
+  const symbol_type& terminal(std::size_t column) const { return parser.terminal_symbols[column]; }
+  const symbol_type& non_terminal(std::size_t column) const { return parser.non_terminal_symbols[column]; }
+
+private:
+  const lr_parser<symbol_type>& parser;
+};
+
+template<class token_source_type, typename tree_factory_type>
+typename tree_factory_type::node_type*
+parse_input_to_tree(lr_parser<typename token_source_type::symbol_type>& parser,
+                    token_source_type& input,
+                    tree_factory_type& tree_factory) {
+  const lr_parser_table<typename token_source_type::symbol_type> table(parser);
+  return parse_input_to_tree(table, input, tree_factory);
+}
+
+template<typename token_source_type>
+void parse_input_to_flat_tree(lr_parser<typename token_source_type::symbol_type>& parser,
+                              token_source_type& input,
+                              std::vector<flat_tree_record<typename token_source_type::symbol_type> >& records) {
+  const lr_parser_table<typename token_source_type::symbol_type> table(parser);
+  parse_input_to_flat_tree(table, input, records);
+}
+
+template<typename token_source_type, typename value_type>
+value_type parse_input_to_value(lr_parser<typename token_source_type::symbol_type>& parser,
+                                token_source_type& input,
+                                const semantic_actions<value_type, typename token_source_type::token_type>& actions) {
+  const lr_parser_table<typename token_source_type::symbol_type> table(parser);
+  return parse_input_to_value(table, input, actions);
+}
+
+template<typename token_source_type>
+bool parse_input(lr_parser<typename token_source_type::symbol_type>& parser,
+                 token_source_type& input) {
+  const lr_parser_table<typename token_source_type::symbol_type> table(parser);
+  return parse_input(table, input);
 }
 
 #endif /* PARSE_INPUT_H */
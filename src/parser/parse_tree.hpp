@@ -1,6 +1,12 @@
 #ifndef _PARSE_TREE_H_
 #define _PARSE_TREE_H_
 
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <type_traits>
+
 namespace parse_tree {
 
   template<typename token_type>
@@ -13,13 +19,21 @@ namespace parse_tree {
     virtual void accept(basic_visitor<token_type>* v) = 0;
   };
 
+  /**
+   * \brief Leaf of the parse tree, which holds its token by value
+   *
+   * With token views (see token_view.hpp), a leaf is built without copying
+   * the lexeme of its token.
+   */
   template<typename token_type>
   class terminal: public node<token_type> {
   public:
-    terminal(const token_type& t);
+    terminal(const token_type& t): t(t) {}
     virtual ~terminal() {}
 
     virtual void accept(basic_visitor<token_type>* v) { v->visit(this); }
+
+    const token_type& token() const { return t; }
     
   private:
     token_type t;
@@ -29,23 +43,187 @@ namespace parse_tree {
   class production: public node<token_type> {
   public:
     typedef typename token_type::symbol_type symbol_type;
-    production(const symbol_type& s);
-    virtual ~production() {}
+
+    template<typename iterator_type>
+    production(const symbol_type& s, unsigned int rule_id, iterator_type begin, iterator_type end)
+      : s(s), rule_id(rule_id), children(begin, end) {}
+    virtual ~production() {
+      for (auto c: children)
+        delete c;
+    }
 
     virtual void accept(basic_visitor<token_type>* v) { v->visit(this); }
-    void add_child(node* n) { children.push_back(n); }
+    void add_child(node<token_type>* n) { children.push_back(n); }
+
+    const symbol_type& symbol() const { return s; }
+    unsigned int production_id() const { return rule_id; }
+    const std::vector<node<token_type>*>& get_children() const { return children; }
     
   private:
     symbol_type s;
-    std::vector<node*> children;
+    unsigned int rule_id;
+    std::vector<node<token_type>*> children;
   };
 
   template<typename token_type>
   class basic_visitor {
   public:
+    virtual ~basic_visitor() {}
     virtual void visit(terminal<token_type>* t) = 0;
     virtual void visit(production<token_type>* p) = 0;
   };
+
+  /**
+   * \brief Tree factory of parse_input_to_tree building parse_tree nodes
+   *
+   * The leaves store the current token of the token source as it is, so the
+   * only allocation per token is the leaf itself.
+   */
+  template<typename token_t>
+  class tree_factory {
+  public:
+    using token_type = token_t;
+    using symbol_type = typename token_type::symbol_type;
+    using node_type = node<token_type>;
+
+    node_type* build_node(node_type** begin,
+                          node_type** end,
+                          unsigned int rule_id,
+                          const symbol_type& s) {
+      return new production<token_type>(s, rule_id, begin, end);
+    }
+
+    template<typename token_source_type>
+    node_type* build_leaf(token_source_type& input) {
+      return new terminal<token_type>(input.get());
+    }
+  };
+
+  /**
+   * \brief Node of an arena_tree
+   *
+   * The children of a production are the range [first_child, first_child +
+   * child_count) of arena_tree::children, which holds node indices.
+   */
+  template<typename token_type>
+  struct arena_node {
+    typedef typename token_type::symbol_type symbol_type;
+
+    // Production id of the terminals:
+    static const unsigned int terminal_id = std::numeric_limits<unsigned int>::max();
+
+    symbol_type symbol;
+    unsigned int production_id;
+    std::uint32_t index;
+    std::uint32_t first_child;
+    std::uint32_t child_count;
+    token_type token;
+
+    bool is_terminal() const { return production_id == terminal_id; }
+  };
+
+  /**
+   * \brief Parse tree whose nodes are bump allocated in blocks
+   *
+   * The nodes are laid out in their creation order, which is the post-order
+   * of the tree, and are never destroyed one by one: clear() releases the
+   * whole tree in constant time and keeps the blocks for the next tree. The
+   * token type must thus be trivially destructible, as token views are.
+   */
+  template<typename token_type>
+  class arena_tree {
+  public:
+    typedef arena_node<token_type> node_type;
+
+    static_assert(std::is_trivially_destructible<token_type>::value,
+                  "The nodes of an arena_tree are not destroyed.");
+
+    explicit arena_tree(std::size_t block_size = 4096)
+      : children(), block_size(block_size), blocks(), count(0) {}
+
+    arena_tree(const arena_tree&) = delete;
+    arena_tree& operator=(const arena_tree&) = delete;
+
+    node_type* allocate() {
+      if (count == blocks.size() * block_size)
+        blocks.emplace_back(new node_type[block_size]);
+
+      node_type* n(&blocks[count / block_size][count % block_size]);
+      n->index = count++;
+      n->first_child = 0;
+      n->child_count = 0;
+      return n;
+    }
+
+    void clear() {
+      count = 0;
+      children.clear();
+    }
+
+    std::size_t size() const { return count; }
+
+    node_type& operator[](std::size_t index) {
+      return blocks[index / block_size][index % block_size];
+    }
+
+    const node_type& operator[](std::size_t index) const {
+      return blocks[index / block_size][index % block_size];
+    }
+
+    const node_type& child(const node_type& n, std::size_t i) const {
+      return (*this)[children[n.first_child + i]];
+    }
+
+    std::vector<std::uint32_t> children;
+
+  private:
+    std::size_t block_size;
+    std::vector<std::unique_ptr<node_type[]> > blocks;
+    std::size_t count;
+  };
+
+  /**
+   * \brief Tree factory of parse_input_to_tree building the nodes of an
+   * arena_tree
+   */
+  template<typename token_t>
+  class arena_tree_factory {
+  public:
+    using token_type = token_t;
+    using symbol_type = typename token_type::symbol_type;
+    using node_type = arena_node<token_type>;
+
+    explicit arena_tree_factory(arena_tree<token_type>& tree): tree(tree) {}
+
+    node_type* build_node(node_type** begin,
+                          node_type** end,
+                          unsigned int rule_id,
+                          const symbol_type& s) {
+      node_type* n(tree.allocate());
+      n->symbol = s;
+      n->production_id = rule_id;
+      n->first_child = tree.children.size();
+      n->child_count = end - begin;
+      for (node_type** it(begin); it != end; ++it)
+        tree.children.push_back((*it)->index);
+      return n;
+    }
+
+    template<typename token_source_type>
+    node_type* build_leaf(token_source_type& input) {
+      node_type* n(tree.allocate());
+      n->symbol = input.get().symbol;
+      n->production_id = node_type::terminal_id;
+      n->token = input.get();
+      return n;
+    }
+
+    // The nodes are released with the tree:
+    void release(node_type*) {}
+
+  private:
+    arena_tree<token_type>& tree;
+  };
 }
 
 #endif /* _PARSE_TREE_H_ */
@@ -0,0 +1,148 @@
+#ifndef _PUSH_PARSER_H_
+#define _PUSH_PARSER_H_
+
+#include <vector>
+
+#include "parse_input.hpp"
+
+
+enum class push_status { need_more_input, accepted, error };
+
+/**
+ * \brief Parser driven by the caller, one token at a time
+ *
+ * The parse stacks are held by the object between the calls to feed(), so
+ * that the input can be fed as it arrives, and many parses can be
+ * interleaved on a single thread. Neither feed() nor finish() blocks or
+ * throws on a syntax error: the status tells if more input is needed, if the
+ * input is accepted, or if it is invalid, in which case expected_symbols()
+ * gives the terminals which were expected instead.
+ *
+ * The tables are accessed through the interface documented in
+ * packed_lr_table.hpp, and the nodes are built by a tree factory, as in
+ * parse_input_to_tree. The leaves are built from a token source whose
+ * current token is the fed token.
+ */
+template<typename table_type, typename tree_factory_type>
+class push_parser {
+public:
+  using symbol_type = typename table_type::symbol_type;
+  using node_type = typename tree_factory_type::node_type;
+  using action_type = typename table_type::action_type;
+
+  push_parser(const table_type& table, tree_factory_type& tree_factory)
+    : table(table), tree_factory(tree_factory), state_stack(), output(tree_factory),
+      root(nullptr), status(push_status::need_more_input), error_state(0) {
+    state_stack.reserve(initial_parse_stack_capacity);
+    state_stack.push_back(0);
+  }
+
+  ~push_parser() { release_root(); }
+
+  push_parser(const push_parser&) = delete;
+  push_parser& operator=(const push_parser&) = delete;
+
+  /**
+   * \brief Perform the reductions triggered by t, then shift it.
+   */
+  template<typename token_type>
+  push_status feed(const token_type& t) {
+    if (status != push_status::need_more_input)
+      return push_status::error;
+
+    std::size_t terminal_id(0);
+    if (not table.find_terminal(t.symbol, terminal_id))
+      return fail();
+
+    for (;;) {
+      const action_type action(table.action(state_stack.back(), terminal_id));
+
+      if (action.kind == action_type::shift) {
+        token_holder<token_type> input{t};
+        shift_parse_stacks(action, state_stack, output, input);
+        break;
+      } else if (action.kind == action_type::reduce) {
+        reduce_parse_stacks(table, action, state_stack, output, t);
+      } else {
+        return fail();
+      }
+    }
+
+    if (state_stack.back() == table.accepting_state()) {
+      root = output.result();
+      status = push_status::accepted;
+    }
+    return status;
+  }
+
+  /**
+   * \brief Feed the end of input token, which must complete the parse.
+   */
+  template<typename token_type>
+  push_status finish(const token_type& eoi) {
+    if (feed(eoi) == push_status::need_more_input)
+      return fail();
+    return status;
+  }
+
+  push_status get_status() const { return status; }
+
+  std::vector<symbol_type> expected_symbols() const {
+    return expected_terminals(table, error_state);
+  }
+
+  /**
+   * \brief Take the tree of an accepted input.
+   */
+  node_type* result() {
+    node_type* tree(root);
+    root = nullptr;
+    return tree;
+  }
+
+  /**
+   * \brief Release the nodes of the current parse, and start a new one.
+   */
+  void reset() {
+    release_root();
+    output.clear();
+    state_stack.assign(1, 0);
+    status = push_status::need_more_input;
+    error_state = 0;
+  }
+
+private:
+  template<typename token_t>
+  struct token_holder {
+    typedef token_t token_type;
+
+    const token_type& t;
+
+    const token_type& get() const { return t; }
+  };
+
+  const table_type& table;
+  tree_factory_type& tree_factory;
+
+  std::vector<std::size_t> state_stack;
+  tree_output<tree_factory_type> output;
+
+  // The tree of the accepted input, until it is taken:
+  node_type* root;
+
+  push_status status;
+  std::size_t error_state;
+
+  push_status fail() {
+    error_state = state_stack.back();
+    return status = push_status::error;
+  }
+
+  void release_root() {
+    if (root)
+      release_node(tree_factory, root, 0);
+    root = nullptr;
+  }
+};
+
+#endif /* _PUSH_PARSER_H_ */
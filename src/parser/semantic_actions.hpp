@@ -0,0 +1,62 @@
+#ifndef _SEMANTIC_ACTIONS_H_
+#define _SEMANTIC_ACTIONS_H_
+
+#include <functional>
+#include <set>
+#include <string>
+#include <vector>
+
+
+/**
+ * \brief Semantic actions of parse_input_to_value, by production id
+ *
+ * The value of a terminal is computed by the shift action from its token.
+ * The value of a production is computed by its action from the values of
+ * its right hand side, given as the range [begin, end) of the value stack,
+ * which the action may move from. A production without action takes the
+ * value of its first symbol, or a default constructed value if it is empty.
+ */
+template<typename value_t, typename token_t>
+class semantic_actions {
+public:
+  typedef value_t value_type;
+  typedef token_t token_type;
+
+  typedef std::function<value_type(const token_type&)> shift_action_type;
+  typedef std::function<value_type(value_type* begin, value_type* end)> reduce_action_type;
+
+  explicit semantic_actions(const shift_action_type& shift_action)
+    : shift_action(shift_action), reduce_actions() {}
+
+  void set(std::size_t production_id, const reduce_action_type& action) {
+    if (production_id >= reduce_actions.size())
+      reduce_actions.resize(production_id + 1);
+    reduce_actions[production_id] = action;
+  }
+
+  value_type shift(const token_type& t) const { return shift_action(t); }
+
+  value_type reduce(std::size_t production_id, value_type* begin, value_type* end) const {
+    if (production_id < reduce_actions.size() and reduce_actions[production_id])
+      return reduce_actions[production_id](begin, end);
+    return begin != end ? std::move(*begin) : value_type();
+  }
+
+  /**
+   * \brief The productions which have an action, which must not be bypassed
+   * by unit rule elimination (see table_options).
+   */
+  std::set<std::size_t> semantic_productions() const {
+    std::set<std::size_t> productions;
+    for (std::size_t i(0); i < reduce_actions.size(); ++i)
+      if (reduce_actions[i])
+        productions.insert(i);
+    return productions;
+  }
+
+private:
+  shift_action_type shift_action;
+  std::vector<reduce_action_type> reduce_actions;
+};
+
+#endif /* _SEMANTIC_ACTIONS_H_ */
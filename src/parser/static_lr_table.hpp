@@ -0,0 +1,158 @@
+#ifndef _STATIC_LR_TABLE_H_
+#define _STATIC_LR_TABLE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+#include "packed_lr_table.hpp"
+#include "parse_input.hpp"
+#include "symbol_traits.hpp"
+
+
+/**
+ * \brief Parse tables compiled in the program
+ *
+ * \c tables is a class generated by write_lr_tables (see lr_table_codegen.hpp),
+ * whose static \c constexpr arrays hold the tables. Nothing is built at run
+ * time, and since the arrays are known to the compiler, it can fold the
+ * lookups with constant indices.
+ *
+ * This class provides the table interface of the parse functions, see
+ * packed_lr_table.hpp.
+ */
+template<typename tables>
+class static_lr_table {
+public:
+  typedef typename tables::symbol_type symbol_type;
+  typedef std::uint32_t index_type;
+  typedef lr_action<index_type> action_type;
+
+  constexpr std::size_t state_count() const { return tables::state_count; }
+  constexpr std::size_t terminal_count() const { return tables::terminal_count; }
+  constexpr std::size_t non_terminal_count() const { return tables::non_terminal_count; }
+
+  constexpr std::size_t accepting_state() const { return tables::accepting_state; }
+
+  static bool find_terminal(const symbol_type& s, std::size_t& column) {
+    return find_terminal(s, column, std::integral_constant<bool, symbol_traits<symbol_type>::is_dense>());
+  }
+
+  action_type action(std::size_t state, std::size_t column) const {
+    const std::int32_t entry(tables::actions[state * tables::terminal_count + column]);
+    if (entry > 0)
+      return action_type{action_type::shift, static_cast<index_type>(entry - 1), 0, 0};
+    if (entry < 0) {
+      const std::size_t production_id(- entry - 1);
+      return action_type{action_type::reduce,
+                         static_cast<index_type>(production_id),
+                         tables::rule_lengths[production_id],
+                         tables::rule_lhs[production_id]};
+    }
+    return action_type{action_type::error, 0, 0, 0};
+  }
+
+  std::size_t goto_state(std::size_t state, std::size_t column) const {
+    const std::int32_t entry(tables::gotos[state * tables::non_terminal_count + column]);
+    return entry > 0 ? entry - 1 : 0;
+  }
+
+  const symbol_type& terminal(std::size_t column) const { return tables::terminals[column]; }
+  const symbol_type& non_terminal(std::size_t column) const { return tables::non_terminals[column]; }
+
+private:
+  static bool find_terminal(const symbol_type& s, std::size_t& column, std::true_type) {
+    if (tables::terminal_column_count == 0)
+      return find_terminal(s, column, std::false_type());
+
+    const std::size_t i(symbol_traits<symbol_type>::index(s));
+    if (i >= tables::terminal_column_count or tables::terminal_columns[i] == 0)
+      return false;
+    column = tables::terminal_columns[i] - 1;
+    return true;
+  }
+
+  static bool find_terminal(const symbol_type& s, std::size_t& column, std::false_type) {
+    const std::uint32_t* begin(tables::terminal_order);
+    const std::uint32_t* end(tables::terminal_order + tables::terminal_count);
+    const std::uint32_t* item(std::lower_bound(begin, end, s, [](std::uint32_t c, const symbol_type& value) {
+          return tables::terminals[c] < value;
+        }));
+    if (item == end or s < tables::terminals[*item])
+      return false;
+    column = *item;
+    return true;
+  }
+};
+
+namespace static_lr_detail {
+  // The states below the top of the stack:
+  typedef std::vector<std::uint32_t> state_stack_type;
+
+  // Reduce the production, from the top state, and return the goto state:
+  template<typename tables, std::size_t production_id>
+  std::size_t reduce(std::size_t state, state_stack_type& stack) {
+    constexpr std::size_t length(tables::rule_lengths[production_id]);
+    constexpr std::size_t lhs(tables::rule_lhs[production_id]);
+
+    if (length == 0) {
+      stack.push_back(state);
+    } else {
+      state = stack[stack.size() - length];
+      stack.resize(stack.size() - length + 1);
+    }
+    return tables::gotos[state * tables::non_terminal_count + lhs] - 1;
+  }
+
+  template<typename tables, std::size_t... production_ids>
+  std::size_t reduce(std::size_t production_id,
+                     std::size_t state,
+                     state_stack_type& stack,
+                     std::index_sequence<production_ids...>) {
+    typedef std::size_t (*reduce_type)(std::size_t, state_stack_type&);
+    static constexpr reduce_type reductions[] = {&reduce<tables, production_ids>...};
+
+    return reductions[production_id](state, stack);
+  }
+}
+
+/**
+ * \brief Recognize the input with the parse tables \c tables, generated by
+ * write_lr_tables
+ *
+ * This is parse_input specialized for tables known at compile time: the
+ * table dimensions and the accepting state are constants, the actions are
+ * decoded in place, and the top of the state stack is kept in a local
+ * variable. Each reduction jumps through a table to a function whose rule
+ * length and left hand side are constants.
+ */
+template<typename tables, typename token_source_type>
+bool static_parse_input(token_source_type& input) {
+  static_lr_detail::state_stack_type stack;
+  stack.reserve(initial_parse_stack_capacity);
+
+  std::size_t state(0);
+  while (state != tables::accepting_state) {
+    std::size_t column(0);
+    if (not static_lr_table<tables>::find_terminal(input.get().symbol, column))
+      throw std::string("parse error near ") + input.get().render_coordinates();
+
+    const std::int32_t entry(tables::actions[state * tables::terminal_count + column]);
+    if (entry > 0) {  // shift
+      stack.push_back(state);
+      state = entry - 1;
+      input.next();
+    } else if (entry < 0) {  // reduce
+      state = static_lr_detail::reduce<tables>(- entry - 1, state, stack,
+                                               std::make_index_sequence<tables::production_count>());
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+#endif /* _STATIC_LR_TABLE_H_ */
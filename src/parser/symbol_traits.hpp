@@ -0,0 +1,163 @@
+#ifndef _SYMBOL_TRAITS_H_
+#define _SYMBOL_TRAITS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+
+
+/**
+ * \brief Dense numbering of the symbols of a grammar
+ *
+ * When \c is_dense is true, \c index(s) maps each symbol to a small integer,
+ * which the parse tables use to find the column of a symbol with a single
+ * array load. This is the case of enumerations and integers, whose index is
+ * their value. \c has_index(s) is false for the symbols which have no index,
+ * such as negative values. Specialize this class to provide the numbering
+ * of other symbol types; the others are looked up in a \c std::map.
+ */
+template<typename symbol_type, typename enable = void>
+struct symbol_traits {
+  static constexpr bool is_dense = false;
+};
+
+namespace symbol_traits_detail {
+  template<typename value_type>
+  bool is_negative(value_type value, std::true_type) { return value < 0; }
+
+  template<typename value_type>
+  bool is_negative(value_type, std::false_type) { return false; }
+
+  template<typename value_type>
+  bool is_negative(value_type value) {
+    return is_negative(value, std::is_signed<value_type>());
+  }
+}
+
+template<typename symbol_type>
+struct symbol_traits<symbol_type,
+                     typename std::enable_if<std::is_enum<symbol_type>::value>::type> {
+  typedef typename std::underlying_type<symbol_type>::type value_type;
+
+  static constexpr bool is_dense = true;
+
+  static bool has_index(const symbol_type& s) {
+    return not symbol_traits_detail::is_negative(static_cast<value_type>(s));
+  }
+
+  static std::size_t index(const symbol_type& s) {
+    return static_cast<std::size_t>(static_cast<value_type>(s));
+  }
+};
+
+template<typename symbol_type>
+struct symbol_traits<symbol_type,
+                     typename std::enable_if<std::is_integral<symbol_type>::value>::type> {
+  static constexpr bool is_dense = true;
+
+  static bool has_index(const symbol_type& s) { return not symbol_traits_detail::is_negative(s); }
+
+  static std::size_t index(const symbol_type& s) { return static_cast<std::size_t>(s); }
+};
+
+
+/**
+ * \brief Column + 1 of each symbol of \c map by \c symbol_traits::index, or 0
+ *
+ * The symbols must have a dense numbering. An empty vector is returned if a
+ * symbol has no index, or if the numbering is too sparse for an array: the
+ * columns are then looked up in the map.
+ */
+template<typename symbol_type, typename column_type>
+std::vector<std::uint32_t> dense_columns(const std::map<symbol_type, column_type>& map) {
+  typedef symbol_traits<symbol_type> traits;
+
+  const std::size_t max_size(4 * map.size() + 256);
+  std::size_t size(0);
+  for (const auto& item: map) {
+    if (not traits::has_index(item.first) or traits::index(item.first) >= max_size)
+      return std::vector<std::uint32_t>();
+    size = std::max(size, traits::index(item.first) + 1);
+  }
+
+  std::vector<std::uint32_t> columns(size, 0);
+  for (const auto& item: map)
+    columns[traits::index(item.first)] = static_cast<std::uint32_t>(item.second + 1);
+  return columns;
+}
+
+
+/**
+ * \brief Map from symbols to table columns
+ *
+ * The columns of symbols with a dense numbering are stored in a vector
+ * indexed by \c symbol_traits::index. A \c std::map is used for the other
+ * symbol types, and when the numbering does not fit a vector (see
+ * dense_columns), for instance with negative enumeration values.
+ */
+template<typename symbol_type>
+class symbol_index {
+  typedef symbol_traits<symbol_type> traits;
+  typedef std::integral_constant<bool, traits::is_dense> is_dense;
+
+public:
+  symbol_index(): columns(), sparse_columns(), dense(false) {}
+
+  template<typename column_type>
+  explicit symbol_index(const std::map<symbol_type, column_type>& map)
+    : columns(), sparse_columns(map.begin(), map.end()), dense(false) {
+    build_dense(is_dense());
+  }
+
+  /**
+   * \brief Find the column of \c s. Return false if \c s has no column.
+   */
+  bool find(const symbol_type& s, std::size_t& column) const {
+    return find(s, column, is_dense());
+  }
+
+private:
+  // Column + 1 of each index, or 0:
+  std::vector<std::uint32_t> columns;
+  std::map<symbol_type, std::size_t> sparse_columns;
+  bool dense;
+
+  void build_dense(std::false_type) {}
+
+  void build_dense(std::true_type) {
+    columns = dense_columns(sparse_columns);
+    if (columns.empty())
+      return;
+
+    sparse_columns.clear();
+    dense = true;
+  }
+
+  bool find_sparse(const symbol_type& s, std::size_t& column) const {
+    const auto item(sparse_columns.find(s));
+    if (item == sparse_columns.end())
+      return false;
+    column = item->second;
+    return true;
+  }
+
+  bool find(const symbol_type& s, std::size_t& column, std::false_type) const {
+    return find_sparse(s, column);
+  }
+
+  bool find(const symbol_type& s, std::size_t& column, std::true_type) const {
+    if (not dense)
+      return find_sparse(s, column);
+
+    const std::size_t i(traits::index(s));
+    if (i >= columns.size() or columns[i] == 0)
+      return false;
+    column = columns[i] - 1;
+    return true;
+  }
+};
+
+#endif /* _SYMBOL_TRAITS_H_ */
@@ -0,0 +1,42 @@
+#ifndef _TOKEN_VIEW_H_
+#define _TOKEN_VIEW_H_
+
+#include <cstddef>
+#include <string>
+
+
+/**
+ * \brief Position of a lexeme in the input, as an offset and a length
+ */
+struct lexeme_span {
+  std::size_t offset;
+  std::size_t length;
+};
+
+
+/**
+ * \brief Token which refers to its lexeme in the input instead of holding a
+ * copy of it
+ *
+ * A token view is a few words, which the token sources fill in place and the
+ * tree factories store by value, so that no memory is allocated per token.
+ * The text of the lexeme is only built when it is asked for, from the input
+ * which retains it (see regex_token_source::lexeme).
+ */
+template<typename symbol_t>
+struct token_view {
+  using symbol_type = symbol_t;
+
+  symbol_type symbol;
+  lexeme_span span;
+  std::size_t line;
+  std::size_t column;
+
+  std::string render_coordinates() const {
+    return std::to_string(line + 1) + ":" + std::to_string(column + 1);
+  }
+
+  token_view* copy() const { return new token_view(*this); }
+};
+
+#endif /* _TOKEN_VIEW_H_ */
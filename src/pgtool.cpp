@@ -12,6 +12,8 @@
 #include "utils/meta.hpp"
 #include "utils/command_line_parser.hpp"
 
+#include "parser/lr_table_codegen.hpp"
+
 
 
 namespace pgSymbols {
@@ -338,6 +340,37 @@ class LRGrammarBuilder: public AstTreeVisitorI {
   virtual void visit(AstLeaf* node) {}
 };
 
+// Write the parse tables of grammar and the DFAs of lexer in a C++ header. The
+//  symbols are written as their ids in the grammar.
+void writeTables(std::ostream& header,
+                 const CFGrammar& grammar,
+                 const LexerBase& lexer) {
+  cf_grammar<Symbol> g(Symbol::START);
+  for (const auto& production: grammar.productionRules)
+    g.add_production(production.first,
+                     symbol_list_type<Symbol>(production.second.begin(),
+                                              production.second.end()));
+  g.wrap_up();
+
+  const lr_parser<Symbol> p(g);
+  auto symbolId = [&g](const Symbol& s) { return g.symbol_id(s); };
+
+  header << "// Symbol ids:" << std::endl;
+  for (const auto& s: g.symbol_set) {
+    const auto name(grammar.symbolsPrettyNames.find(s));
+    if (name != grammar.symbolsPrettyNames.end())
+      header << "//   " << symbolId(s) << ": " << name->second << std::endl;
+  }
+  header << std::endl;
+
+  write_lr_tables(header, p, "pg_parser", "unsigned int",
+                  [&symbolId](std::ostream& stream, const Symbol& s) {
+                    stream << symbolId(s);
+                  });
+  header << std::endl;
+  lexer.writeTables(header, "pg_lexer", symbolId);
+}
+
 int main(int argc, char** argv) {
   CommandLine cmd;
   
@@ -349,9 +382,16 @@ int main(int argc, char** argv) {
   ParameterArgument<std::string>
       source_filename('s', "File name of the source to "
                       "be checked against a given "
-                      "grammar.", "filename", false);
+                      "grammar.", "filename", true);
   cmd.add(&source_filename);
 
+  ParameterArgument<std::string>
+      header_filename('o', "File name of a C++ header where "
+                      "the parse tables and the lexer DFAs "
+                      "are written as constexpr arrays.",
+                      "filename", true);
+  cmd.add(&header_filename);
+
   SwitchArgument
       tokenize('t', "Tokenize the source file instead "
                "of attempting to parse it.");
@@ -390,12 +430,26 @@ int main(int argc, char** argv) {
         p.print(std::cout, generated_grammar);
           
       LexerBase generated_lexer(g.ruleBuilder.generateLexer());
-      generated_lexer.setInput(source_stream);
 
+      if (header_filename.defined()) {
+        std::ofstream header(header_filename.value().c_str(), std::ios::out);
+        if (not header)
+          throw std::string("Cannot open ") + header_filename.value() + " for writing.";
+
+        writeTables(header, generated_grammar, generated_lexer);
+        header.close();
+        if (not header)
+          throw std::string("Cannot write the tables to ") + header_filename.value() + ".";
+        std::cout << "Tables written to " << header_filename.value() << std::endl;
+      }
 
-      if (tokenize.value()) {
+      if (not source_filename.defined()) {
+        // Nothing to check.
+      } else if (tokenize.value()) {
+        generated_lexer.setInput(source_stream);
         tokenizeInput(generated_lexer, generated_grammar);
       } else {
+        generated_lexer.setInput(source_stream);
         AstNode* source_ast(NULL);
         if ((source_ast = ParseInputToAst(p,
                                           generated_grammar,
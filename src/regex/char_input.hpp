@@ -24,7 +24,9 @@ class CharInput {
         column_number(0),
         stream(s),
         buffer(0),
-        start_index(0) {}
+        start_index(0),
+        purged_bytes(0),
+        retain(false) {}
   
   bool get(std::size_t pos, char& c) {
     if (increase_buffered_data(start_index + pos + 1)) {
@@ -45,6 +47,44 @@ class CharInput {
     return (buffer.size() - start_index) > 0;
   }
 
+  // Offset of the next character from the beginning of the input:
+  std::size_t position() const {
+    return purged_bytes + start_index;
+  }
+
+  // Consume length characters, as extract_substring, without copying them.
+  void skip(std::size_t length) {
+    if (increase_buffered_data(start_index + length)) {
+      update_coordinates(length);
+      start_index += length;
+      purge();
+    } else {
+      throw std::string("CharInput::skip(length)"
+                        " - not enought available bytes.");
+    }
+  }
+
+  // In retaining mode, the consumed characters are kept in the buffer, so
+  //  that a lexeme can be read back from its offset and length.
+  void set_retain(bool r) {
+    retain = r;
+  }
+
+  // In retaining mode, drop the characters before offset, whose lexemes are
+  //  no longer read back. The characters which are not consumed are kept.
+  void release(std::size_t offset) {
+    if (offset > purged_bytes)
+      drop(std::min(offset, position()) - purged_bytes);
+  }
+
+  std::string lexeme(std::size_t offset, std::size_t length) const {
+    if (offset < purged_bytes or offset + length > purged_bytes + buffer.size())
+      throw std::string("CharInput::lexeme(offset, length)"
+                        " - the lexeme is not retained.");
+    return std::string(buffer.begin() + (offset - purged_bytes),
+                       buffer.begin() + (offset - purged_bytes + length));
+  }
+
   std::string extract_substring(std::size_t length) {
     if (increase_buffered_data(start_index + length)) {
       std::string s(buffer.begin() + start_index,
@@ -78,6 +118,7 @@ class CharInput {
     buffer.clear();
 
     start_index = 0;
+    purged_bytes = 0;
 
     line_number = 0;
     column_number = 0;
@@ -90,6 +131,8 @@ class CharInput {
   std::istream* stream;
   std::vector<char> buffer;
   std::size_t start_index;
+  std::size_t purged_bytes;
+  bool retain;
 
   bool increase_buffered_data(std::size_t length) {
     if (not stream)
@@ -113,9 +156,21 @@ class CharInput {
   }
 
   void purge() {
-    std::memmove(&buffer[0], &buffer[start_index], buffer.size() - start_index);
-    buffer.resize(buffer.size() - start_index);
-    start_index = 0;
+    if (retain)
+      return;
+
+    drop(start_index);
+  }
+
+  // Remove the count first characters of the buffer, which are consumed:
+  void drop(std::size_t count) {
+    if (count == 0)
+      return;
+
+    purged_bytes += count;
+    std::memmove(&buffer[0], &buffer[count], buffer.size() - count);
+    buffer.resize(buffer.size() - count);
+    start_index -= count;
   }
 
   void update_coordinates(std::size_t length) {
@@ -125,11 +180,11 @@ class CharInput {
     line_number += crossed_lines_number;
     
     if (crossed_lines_number > 0) {
-      column_number = start_index
-          - std::distance(std::find(buffer.rend() - start_index - length,
-                                    buffer.rend() - start_index,
-                                    '\n'),
-                          buffer.rend());
+      // The column is the number of characters after the last new line:
+      const std::vector<char>::const_reverse_iterator
+          end(buffer.begin() + start_index + length),
+          begin(buffer.begin() + start_index);
+      column_number = std::distance(end, std::find(end, begin, '\n'));
     } else {
       column_number += length;
     }
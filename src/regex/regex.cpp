@@ -1,6 +1,7 @@
-#include <list>
+#include <cctype>
+#include <cstdint>
 #include <string>
-#include <stack>
+#include <unordered_map>
 #include <vector>
 
 #include "regex.hpp"
@@ -10,7 +11,7 @@
 std::ostream& operator<<(std::ostream& flux, const RegexConfiguration& c) {
   flux << "[ ";
   for (unsigned int i(0); i < c.size(); ++i)
-    flux << c[i] << " ";
+    flux << c.test(i) << " ";
   flux << "]";
   return flux;
 }
@@ -21,90 +22,299 @@ void printConfiguration(std::ostream& flux,
     flux << conf[i] << std::endl;
 }
 
-void printTransitionTable(std::ostream& flux,
-                          const std::vector< std::vector< size_t > >& table) {
+void printTransitionTable(std::ostream& flux, const regex& r) {
   flux << std::string(2*32+3, ' ');
   for (char c(32); c < 127; ++c)
     flux << std::setw(2) << std::right << c;
   flux << std::endl;
-  for (unsigned int i(0); i < table.size(); ++i) {
+  for (unsigned int i(0); i < r.stateCount(); ++i) {
       flux << i + 1 << ": ";
 
       for (char c(0); c < 127; ++c)
-        flux << std::setw(2) << std::right << table[i][c];
+        flux << std::setw(2) << std::right << r.transitionTable[r.transition(i, c)];
 
       flux << std::endl;
     }
 }
 
-void printAcceptTransitionTable(std::ostream& flux,
-                                const std::vector<std::vector<size_t> >& table) {
-  for (unsigned int i(0); i < table.size(); ++i) {
-    for (unsigned int j(0); j < table.size(); ++j)
-      flux << std::setw(2) << std::right << table[i][j];
+void printAcceptTransitionTable(std::ostream& flux, const regex& r) {
+  for (unsigned int i(0); i < r.stateCount(); ++i) {
+    for (unsigned int j(0); j < r.classCount; ++j)
+      flux << std::setw(2) << std::right << r.acceptTransitionTable[i * r.classCount + j];
     flux << std::endl;
   }
 }
 
-void regex::buildRegexConfigurations(astRegexNode* ast) {
+RegexPositionAutomaton::RegexPositionAutomaton(astRegexNode* ast)
+  : configurationSize(ast->getConfigurationSize(0) + 1),
+    first(configurationSize),
+    last(configurationSize),
+    follow(configurationSize, RegexConfiguration(configurationSize)),
+    matching(regexAlphabetSize, RegexConfiguration(configurationSize)),
+    tokenIds(),
+    tokenRanks(configurationSize, static_cast<size_t>(-1)) {
+  bool nullable(false);
+  ast->buildPositions(*this, first, last, nullable);
+
+  // The token count is only known now:
+  for (auto& rank: tokenRanks)
+    rank = std::min(rank, tokenIds.size());
+}
+
+void RegexPositionAutomaton::addToken(size_t tokenId,
+                                      const RegexConfiguration& positions) {
+  const size_t rank(tokenIds.size());
+  tokenIds.push_back(tokenId);
+  positions.for_each([&](size_t position) {
+      tokenRanks[position] = std::min(tokenRanks[position], rank);
+    });
+}
+
+// The characters matched by the same positions are in the same class. The
+//  positions which match the characters of each class are returned.
+std::vector<RegexConfiguration>
+regex::buildCharacterClasses(const RegexPositionAutomaton& automaton) {
+  const RegexConfiguration noPosition(automaton.configurationSize);
+  std::vector<RegexConfiguration> classMatching(1, noPosition);
+  std::unordered_map<RegexConfiguration, size_t, bit_set_hash> classIds;
+  classIds.emplace(noPosition, 0);
+
+  characterClasses.fill(0);
+  for (size_t c(0); c < regexAlphabetSize; ++c) {
+    const auto id(classIds.emplace(automaton.matching[c], classMatching.size()));
+    if (id.second)
+      classMatching.push_back(automaton.matching[c]);
+    characterClasses[c] = id.first->second;
+  }
+
+  classCount = classMatching.size();
+  return classMatching;
+}
+
+// The subset construction of the Glushkov automaton, as a single worklist
+//  pass: the transitions of each configuration are computed once, when it is
+//  visited, and the configurations are numbered in the order they are found,
+//  so that the states after the visited one in configurationSet are the
+//  worklist. The successor configurations are looked up in a hash map.
+void regex::buildRegexAutomaton(astRegexNode* ast) {
   configurationSet.clear();
+  transitionTable.clear();
+  acceptTransitionTable.clear();
 
-  RegexConfiguration startConf(ast->getConfigurationSize(0) + 1, false);
-  ast->setPred(startConf);
-
-  std::stack<RegexConfiguration> visitList;
-  visitList.push(startConf);
-
-  while (visitList.size()) {
-      const RegexConfiguration current(visitList.top());
-      visitList.pop();
-      
-      if (std::find(configurationSet.begin(),
-          configurationSet.end(),
-          current) == configurationSet.end()) {
-          configurationSet.push_back(current);
-          for (char c(0); c < 127; ++c) {
-              std::list< size_t > accept;
-              RegexConfiguration succ(startConf.size(), false);
-              succ.back() = ast->advance(current, succ, accept, c);
-
-              if (std::count(succ.begin(), succ.end(), true))
-                visitList.push(succ);
-            }
-        }
+  const RegexPositionAutomaton automaton(ast);
+  const std::vector<RegexConfiguration> classMatching(buildCharacterClasses(automaton));
+  const size_t acceptingBit(automaton.configurationSize - 1);
+  const size_t noToken(automaton.tokenIds.size());
+
+  std::unordered_map<RegexConfiguration, size_t, bit_set_hash> stateIds;
+  stateIds.emplace(automaton.first, 0);
+  configurationSet.push_back(automaton.first);
+
+  // The matching positions and the successor configuration of each step,
+  //  which are reused:
+  RegexConfiguration matched(automaton.configurationSize);
+  RegexConfiguration succ(automaton.configurationSize);
+
+  for (size_t i(0); i < configurationSet.size(); ++i) {
+    transitionTable.resize(transitionTable.size() + classCount, 0);
+    acceptTransitionTable.resize(acceptTransitionTable.size() + classCount, 0);
+
+    // The class 0 has no transitions:
+    for (size_t c(1); c < classCount; ++c) {
+      matched = configurationSet[i];
+      matched &= classMatching[c];
+      if (matched.none())
+        continue;
+
+      size_t rank(noToken);
+      succ.clear();
+      matched.for_each([&](size_t position) {
+          succ |= automaton.follow[position];
+          rank = std::min(rank, automaton.tokenRanks[position]);
+        });
+      if (matched.intersects(automaton.last))
+        succ.set(acceptingBit);
+
+      if (succ.none())
+        continue;
+
+      auto state(stateIds.find(succ));
+      if (state == stateIds.end()) {
+        state = stateIds.emplace(succ, configurationSet.size()).first;
+        configurationSet.push_back(succ);
+      }
+
+      transitionTable[i * classCount + c] = state->second + 1;
+      if (rank != noToken)
+        acceptTransitionTable[i * classCount + c] = automaton.tokenIds[rank];
     }
+  }
 }
 
-void regex::buildRegexTransitionTable(astRegexNode* ast) {
-  transitionTable.clear();
-  transitionTable.resize(configurationSet.size(),
-                           std::vector<size_t>(127, 0));
+// Hopcroft's partition refinement. The missing transitions go to a dead
+//  state, whose id is the state count, so that the automaton is complete.
+//  Since the accepted tokens are on the transitions, the initial partition
+//  separates the states by their accepting bit and by the token accepted on
+//  each character class. Then, the blocks are split by the sets of the
+//  states whose transition on a class leads to a block of the worklist, and the
+//  smaller half of each split block is added to the worklist.
+void regex::minimizeRegexAutomaton() {
+  const size_t completeStateCount(configurationSet.size() + 1);
+  const size_t dead(completeStateCount - 1);
+  unminimizedStateCount = dead;
 
-  acceptTransitionTable.clear();
-  acceptTransitionTable.resize(configurationSet.size(),
-                               std::vector<size_t>(configurationSet.size(), 0));
-
-  for (unsigned int i(0); i < configurationSet.size(); ++i) {
-      const RegexConfiguration& current(configurationSet[i]);
-      for (unsigned int c(0); c < 127; ++c) {
-        std::list<std::size_t> accept;
-          RegexConfiguration succ(current.size(), false);
-          succ.back() = ast->advance(current, succ, accept, c);
-          
-          if (std::count(succ.begin(), succ.end(), true)) {
-              std::vector<RegexConfiguration>::iterator
-                succInTable(std::find(configurationSet.begin(),
-                                      configurationSet.end(),
-                                      succ));
-              transitionTable[i][c] = (std::distance(configurationSet.begin(),
-                                                     succInTable)
-                                       + 1);
-              if(accept.size())
-		acceptTransitionTable[i][std::distance(configurationSet.begin(),
-						       succInTable)] = accept.front();
-            }
-        }
+  auto target = [&](size_t s, size_t c) -> size_t {
+    return s == dead or transitionTable[s * classCount + c] == 0
+      ? dead
+      : transitionTable[s * classCount + c] - 1;
+  };
+
+  // The sources of the transitions to t on c are the range
+  //  [sourceBegin[c * completeStateCount + t], sourceBegin[c * completeStateCount + t + 1]).
+  std::vector<size_t> sourceBegin(classCount * completeStateCount + 1, 0);
+  std::vector<size_t> sources(classCount * completeStateCount);
+  for (size_t c(0); c < classCount; ++c)
+    for (size_t s(0); s < completeStateCount; ++s)
+      ++sourceBegin[c * completeStateCount + target(s, c) + 1];
+  for (size_t i(1); i < sourceBegin.size(); ++i)
+    sourceBegin[i] += sourceBegin[i - 1];
+  {
+    std::vector<size_t> next(sourceBegin.begin(), sourceBegin.end() - 1);
+    for (size_t c(0); c < classCount; ++c)
+      for (size_t s(0); s < completeStateCount; ++s)
+        sources[next[c * completeStateCount + target(s, c)]++] = s;
+  }
+
+  // The blocks are the ranges [blockBegin[b], blockEnd[b]) of elements, and
+  //  the marked states of a block are the first ones of its range.
+  std::vector<size_t> elements(completeStateCount), location(completeStateCount), blockOf(completeStateCount);
+  std::vector<size_t> blockBegin, blockEnd, marked;
+
+  std::map<std::vector<size_t>, size_t> initialBlocks;
+  for (size_t s(0); s < completeStateCount; ++s) {
+    std::vector<size_t> signature(1, s != dead and configurationSet[s].test(configurationSet[s].size() - 1));
+    if (s != dead)
+      signature.insert(signature.end(),
+                       acceptTransitionTable.begin() + s * classCount,
+                       acceptTransitionTable.begin() + (s + 1) * classCount);
+    else
+      signature.resize(classCount + 1, 0);
+    blockOf[s] = initialBlocks.emplace(signature, initialBlocks.size()).first->second;
+  }
+
+  const size_t initialBlockCount(initialBlocks.size());
+  blockBegin.assign(initialBlockCount + 1, 0);
+  for (size_t s(0); s < completeStateCount; ++s)
+    ++blockBegin[blockOf[s] + 1];
+  for (size_t b(1); b <= initialBlockCount; ++b)
+    blockBegin[b] += blockBegin[b - 1];
+  blockEnd.assign(blockBegin.begin(), blockBegin.end() - 1);
+  blockBegin.pop_back();
+  for (size_t s(0); s < completeStateCount; ++s) {
+    location[s] = blockEnd[blockOf[s]]++;
+    elements[location[s]] = s;
+  }
+  marked.assign(initialBlockCount, 0);
+
+  std::vector< std::pair<size_t, size_t> > worklist;
+  std::vector<bool> inWorklist(initialBlockCount * classCount, false);
+  auto addSplitter = [&](size_t b, size_t c) {
+    worklist.push_back(std::make_pair(b, c));
+    inWorklist[b * classCount + c] = true;
+  };
+
+  size_t largest(0);
+  for (size_t b(1); b < initialBlockCount; ++b)
+    if (blockEnd[b] - blockBegin[b] > blockEnd[largest] - blockBegin[largest])
+      largest = b;
+  for (size_t b(0); b < initialBlockCount; ++b)
+    if (b != largest)
+      for (size_t c(0); c < classCount; ++c)
+        addSplitter(b, c);
+
+  std::vector<size_t> splitter, touched;
+  while (not worklist.empty()) {
+    const size_t a(worklist.back().first), c(worklist.back().second);
+    worklist.pop_back();
+    inWorklist[a * classCount + c] = false;
+
+    splitter.clear();
+    for (size_t i(blockBegin[a]); i < blockEnd[a]; ++i) {
+      const size_t t(elements[i]);
+      splitter.insert(splitter.end(),
+                      sources.begin() + sourceBegin[c * completeStateCount + t],
+                      sources.begin() + sourceBegin[c * completeStateCount + t + 1]);
     }
+
+    touched.clear();
+    for (const size_t s: splitter) {
+      const size_t b(blockOf[s]);
+      if (marked[b] == 0)
+        touched.push_back(b);
+
+      const size_t i(blockBegin[b] + marked[b]++);
+      const size_t other(elements[i]);
+      std::swap(elements[i], elements[location[s]]);
+      location[other] = location[s];
+      location[s] = i;
+    }
+
+    for (const size_t b: touched) {
+      const size_t markedCount(marked[b]);
+      marked[b] = 0;
+      if (markedCount == blockEnd[b] - blockBegin[b])
+        continue;
+
+      const size_t split(blockBegin.size());
+      blockBegin.push_back(blockBegin[b]);
+      blockEnd.push_back(blockBegin[b] + markedCount);
+      marked.push_back(0);
+      blockBegin[b] += markedCount;
+      for (size_t i(blockBegin[split]); i < blockEnd[split]; ++i)
+        blockOf[elements[i]] = split;
+
+      inWorklist.resize(blockBegin.size() * classCount, false);
+      const bool splitIsSmaller(markedCount <= blockEnd[b] - blockBegin[b]);
+      for (size_t d(0); d < classCount; ++d)
+        addSplitter(inWorklist[b * classCount + d] or splitIsSmaller ? split : b, d);
+    }
+  }
+
+  // The states are the blocks reachable from the block of the start state,
+  //  numbered in the order they are found. The transitions to the block of
+  //  the dead state are removed, unless they accept a token.
+  const size_t none(static_cast<size_t>(-1));
+  std::vector<size_t> stateIds(blockBegin.size(), none), representatives(1, 0);
+  stateIds[blockOf[0]] = 0;
+
+  std::vector<std::uint32_t> transitions, accepts;
+  for (size_t i(0); i < representatives.size(); ++i) {
+    const size_t s(representatives[i]);
+    transitions.resize(transitions.size() + classCount, 0);
+    accepts.insert(accepts.end(),
+                   acceptTransitionTable.begin() + s * classCount,
+                   acceptTransitionTable.begin() + (s + 1) * classCount);
+
+    for (size_t c(0); c < classCount; ++c) {
+      const size_t t(target(s, c));
+      if (t == dead or (blockOf[t] == blockOf[dead] and accepts[i * classCount + c] == 0))
+        continue;
+
+      if (stateIds[blockOf[t]] == none) {
+        stateIds[blockOf[t]] = representatives.size();
+        representatives.push_back(t);
+      }
+      transitions[i * classCount + c] = stateIds[blockOf[t]] + 1;
+    }
+  }
+
+  std::vector<RegexConfiguration> configurations;
+  for (const size_t s: representatives)
+    configurations.push_back(configurationSet[s]);
+
+  configurationSet.swap(configurations);
+  transitionTable.swap(transitions);
+  acceptTransitionTable.swap(accepts);
 }
 
 bool matchRegex(regex& r, const std::string& s) {
@@ -113,7 +323,7 @@ bool matchRegex(regex& r, const std::string& s) {
   size_t stringPosition(0);
   while (!abort) {
       if (stringPosition < s.size()) {
-          const size_t nextState(r.transitionTable[currentState][s[stringPosition]]);
+          const size_t nextState(r.transitionTable[r.transition(currentState, s[stringPosition])]);
           if (nextState) {
               currentState = nextState - 1;
               ++stringPosition;
@@ -125,14 +335,14 @@ bool matchRegex(regex& r, const std::string& s) {
       }
     }
   return stringPosition == s.size()
-      and r.configurationSet[currentState].back();
+      and r.configurationSet[currentState].test(r.configurationSet[currentState].size() - 1);
 }
 
 
-bool match_regex_longest(regex& r,
-                         CharInput& input,
-                         std::string& token,
-                         unsigned int& token_id) {
+bool match_regex_length(regex& r,
+                        CharInput& input,
+                        std::size_t& length,
+                        unsigned int& token_id) {
   bool matched(false);
   std::size_t last_matching_position(0);
   unsigned int last_matching_token_id(0);
@@ -149,12 +359,13 @@ bool match_regex_longest(regex& r,
     if (at_eos) {
       abort = true;
     } else {
-      const std::size_t next_state(r.transitionTable[current_state][c]);
+      const std::size_t transition(r.transition(current_state, c));
+      const std::size_t next_state(r.transitionTable[transition]);
       if (next_state != 0) {
-        if (r.acceptTransitionTable[current_state][next_state - 1]) {
+        if (r.acceptTransitionTable[transition]) {
           matched = true;
           last_matching_position = i;
-          last_matching_token_id = r.acceptTransitionTable[current_state][next_state - 1];
+          last_matching_token_id = r.acceptTransitionTable[transition];
         }
         current_state = next_state - 1;
       } else {
@@ -165,10 +376,73 @@ bool match_regex_longest(regex& r,
   }
 
   if (matched) {
-    token = input.extract_substring(last_matching_position + 1);
+    length = last_matching_position + 1;
     token_id = last_matching_token_id;
-    return true;
-  } else {
+  }
+  return matched;
+}
+
+bool match_regex_longest(regex& r,
+                         CharInput& input,
+                         std::string& token,
+                         unsigned int& token_id) {
+  std::size_t length(0);
+  if (not match_regex_length(r, input, length, token_id))
     return false;
+
+  token = input.extract_substring(length);
+  return true;
+}
+
+void writeRegexTables(std::ostream& flux,
+                      const regex& r,
+                      const std::string& name) {
+  const std::string instance(name + "_dfa");
+  std::string guard(name);
+  std::transform(guard.begin(), guard.end(), guard.begin(), ::toupper);
+
+  flux << "// DFA generated by writeRegexTables(). Do not edit.\n"
+       << "#ifndef _" << guard << "_DFA_H_\n"
+       << "#define _" << guard << "_DFA_H_\n\n"
+       << "#include <cstddef>\n"
+       << "#include <cstdint>\n\n"
+       << "template<typename = void>\n"
+       << "struct " << instance << " {\n"
+       << "  static constexpr std::size_t stateCount = " << r.stateCount() << ";\n"
+       << "  static constexpr std::size_t classCount = " << r.classCount << ";\n\n";
+
+  // characterClasses[c] is the class of the character c, transitions[s *
+  //  classCount + k] the next state + 1, or 0, and accepts[s * classCount + k]
+  //  the token accepted by the transition, or 0.
+  std::ostringstream classes, transitions, accepts;
+  for (std::size_t c(0); c < r.characterClasses.size(); ++c)
+    classes << (c % 16 ? " " : "\n    ") << static_cast<unsigned int>(r.characterClasses[c]) << ",";
+  for (std::size_t i(0); i < r.transitionTable.size(); ++i) {
+    const char* separator(i % 16 ? " " : "\n    ");
+    transitions << separator << r.transitionTable[i] << ",";
+    accepts << separator << (r.transitionTable[i] ? r.acceptTransitionTable[i] : 0) << ",";
   }
+
+  flux << "  static constexpr std::uint8_t characterClasses[] = {" << classes.str() << "\n  };\n"
+       << "  static constexpr std::uint32_t transitions[] = {" << transitions.str() << "\n  };\n"
+       << "  static constexpr std::uint32_t accepts[] = {" << accepts.str() << "\n  };\n"
+       << "  static constexpr bool accepting[] = {";
+  for (std::size_t i(0); i < r.configurationSet.size(); ++i)
+    flux << (i % 16 ? " " : "\n    ") << (r.configurationSet[i].test(r.configurationSet[i].size() - 1) ? "true" : "false") << ",";
+  flux << "\n  };\n};\n\n";
+
+  const char* const members[][2] = {
+    {"std::size_t", "stateCount"},
+    {"std::size_t", "classCount"},
+    {"std::uint8_t", "characterClasses[]"},
+    {"std::uint32_t", "transitions[]"},
+    {"std::uint32_t", "accepts[]"},
+    {"bool", "accepting[]"}
+  };
+  for (unsigned int i(0); i < 6; ++i)
+    flux << "template<typename T> constexpr " << members[i][0] << " "
+         << instance << "<T>::" << members[i][1] << ";\n";
+
+  flux << "\ntypedef " << instance << "<> " << name << ";\n\n"
+       << "#endif\n";
 }
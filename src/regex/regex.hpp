@@ -1,6 +1,8 @@
 #ifndef _MYREGEX_H_
 #define _MYREGEX_H_
 
+#include <array>
+#include <cstdint>
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -14,48 +16,130 @@
 #include <iterator>
 
 #include "char_input.hpp"
+#include "../utils/bit_set.hpp"
 
-typedef std::vector<bool> RegexConfiguration;
+// The set of the active positions of the non deterministic finite automaton,
+//  and the accepting bit, which is the last one.
+typedef bit_set RegexConfiguration;
+
+// The characters matched by the regexes are the ASCII codes below this one.
+const size_t regexAlphabetSize(127);
 
 class astRegexNode;
 
+struct RegexPositionAutomaton;
+
 struct regex {
   // The ordered set of all the configurations of a non deterministic finite
-  //  automaton.
+  //  automaton. After the minimization, each state has the configuration of
+  //  one of the states it replaces.
   std::vector<RegexConfiguration> configurationSet;
 
+  // The characters which no regex distinguishes have the same class, and the
+  //  tables have one column per class. The class 0 is the one of the
+  //  characters which no regex matches, including the ones above the
+  //  alphabet.
+  std::array<std::uint8_t, 256> characterClasses;
+  size_t classCount;
+
   // For each state s_i \in S, the transition function T(s_i, alpha) \in S for
-  //  each symbol alpha \in \Sigma.
-  std::vector< std::vector< size_t > > transitionTable;
+  //  each class alpha \in \Sigma, at s_i * classCount + alpha: the next state
+  //  + 1, or 0.
+  std::vector<std::uint32_t> transitionTable;
+
+  // For each transition T(s_i, alpha), at the same index, gives the tokenId
+  //  which is accepted, if any.
+  std::vector<std::uint32_t> acceptTransitionTable;
 
-  // For each transition from a state to another, gives the tokenId which is
-  //  accepted, if any.
-  std::vector< std::vector< size_t > > acceptTransitionTable;
+  // The number of states of the DFA before its minimization.
+  size_t unminimizedStateCount;
+
+  size_t stateCount() const { return configurationSet.size(); }
+
+  // The index of the transition from state on c in the tables:
+  size_t transition(size_t state, char c) const {
+    return state * classCount + characterClasses[static_cast<unsigned char>(c)];
+  }
 
  private:
-  void buildRegexConfigurations(astRegexNode* ast);
-  void buildRegexTransitionTable(astRegexNode* ast);
+  std::vector<RegexConfiguration> buildCharacterClasses(const RegexPositionAutomaton& automaton);
+  void buildRegexAutomaton(astRegexNode* ast);
+  void minimizeRegexAutomaton();
 
  public:
   explicit regex(astRegexNode* ast): configurationSet(),
+                                     characterClasses(),
+                                     classCount(0),
                                      transitionTable(),
-                                     acceptTransitionTable() {
-    buildRegexConfigurations(ast);
-    buildRegexTransitionTable(ast);
+                                     acceptTransitionTable(),
+                                     unminimizedStateCount(0) {
+    buildRegexAutomaton(ast);
+    minimizeRegexAutomaton();
   }
 };
 
 std::ostream& operator<<(std::ostream& flux, const RegexConfiguration& c);
 void printConfiguration(std::ostream& flux,
                         const std::vector<RegexConfiguration>& conf);
-void printTransitionTable(std::ostream& flux,
-                          const std::vector< std::vector< size_t > >& table);
-void printAcceptTransitionTable(std::ostream& flux,
-                                const std::vector< std::vector< size_t > >& table);
+void printTransitionTable(std::ostream& flux, const regex& r);
+void printAcceptTransitionTable(std::ostream& flux, const regex& r);
 bool matchRegex(regex& r, const std::string& s);
 bool match_regex_longest(regex& r,
                          CharInput& input,
                          std::string& token,
                          unsigned int& tokenId);
 
+// Same as match_regex_longest, but the input is not consumed: only the
+//  length of the longest match is returned.
+bool match_regex_length(regex& r,
+                        CharInput& input,
+                        std::size_t& length,
+                        unsigned int& tokenId);
+
+// Write the transition tables of r as the constexpr arrays of the class name,
+//  in a C++ header. The accepted token id is stored for each transition,
+//  instead of each pair of states.
+void writeRegexTables(std::ostream& flux,
+                      const regex& r,
+                      const std::string& name);
+
+// Same as match_regex_length, with the DFA generated by writeRegexTables.
+template<typename dfa>
+bool match_regex_length(CharInput& input,
+                        std::size_t& length,
+                        unsigned int& token_id) {
+  bool matched(false);
+  std::size_t i(0);
+  std::size_t current_state(0);
+  char c(0);
+  while (input.get(i, c)) {
+    const std::size_t transition(current_state * dfa::classCount
+                                 + dfa::characterClasses[static_cast<unsigned char>(c)]);
+    if (dfa::transitions[transition] == 0)
+      break;
+
+    if (dfa::accepts[transition]) {
+      matched = true;
+      length = i + 1;
+      token_id = dfa::accepts[transition];
+    }
+    current_state = dfa::transitions[transition] - 1;
+    ++i;
+  }
+  return matched;
+}
+
+// Same as match_regex_longest, with the DFA generated by writeRegexTables.
+template<typename dfa>
+bool match_regex_longest(CharInput& input,
+                         std::string& token,
+                         unsigned int& token_id) {
+  std::size_t length(0);
+  if (not match_regex_length<dfa>(input, length, token_id))
+    return false;
+
+  token = input.extract_substring(length);
+  return true;
+}
+
 #endif /* _MYREGEX_H_ */
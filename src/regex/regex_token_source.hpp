@@ -0,0 +1,98 @@
+#ifndef _REGEX_TOKEN_SOURCE_H_
+#define _REGEX_TOKEN_SOURCE_H_
+
+#include <string>
+#include <vector>
+
+#include "char_input.hpp"
+#include "regex.hpp"
+#include "../parser/token_view.hpp"
+
+
+/**
+ * \brief Token source of the parse functions which lexes a CharInput with
+ * compiled regular expressions
+ *
+ * The tokens are token views: the lexemes are skipped in the input instead
+ * of being extracted, and the input is switched to retaining mode so that
+ * the text of a token can be read back with lexeme(). No memory is allocated
+ * per token.
+ *
+ * The input keeps the text of every token until it is released: when the
+ * input is streamed, call release_before() with the oldest token whose
+ * lexeme is still needed, otherwise the whole input stays in memory.
+ *
+ * \param tokens DFA of the tokens, whose token ids start at 1.
+ * \param skipper DFA of the characters skipped between the tokens, or NULL.
+ * \param symbols Symbol of each token id - 1.
+ * \param eoi Symbol returned at the end of the input.
+ */
+template<typename symbol_t>
+class regex_token_source {
+public:
+  using symbol_type = symbol_t;
+  using token_type = token_view<symbol_type>;
+
+  regex_token_source(regex& tokens,
+                     regex* skipper,
+                     const std::vector<symbol_type>& symbols,
+                     const symbol_type& eoi,
+                     CharInput& input)
+    : tokens(tokens), skipper(skipper), symbols(symbols), eoi(eoi),
+      input(input), current() {
+    input.set_retain(true);
+    next();
+  }
+
+  const token_type& get() const { return current; }
+
+  void next() {
+    unsigned int token_id(0);
+    std::size_t length(0);
+    if (skipper and match_regex_length(*skipper, input, length, token_id))
+      input.skip(length);
+
+    const CharInput::Coordinates coordinates(input.get_coordinates());
+    current.line = coordinates.line_number;
+    current.column = coordinates.column_number;
+    current.span.offset = input.position();
+    current.span.length = 0;
+
+    if (not input.good()) {
+      current.symbol = eoi;
+    } else if (match_regex_length(tokens, input, length, token_id)) {
+      current.symbol = symbols[token_id - 1];
+      current.span.length = length;
+      input.skip(length);
+    } else {
+      throw std::string("regex_token_source::next() - Unrecognized token at ")
+        + current.render_coordinates();
+    }
+  }
+
+  /**
+   * \brief Copy the text of the token t, read from this source.
+   */
+  std::string lexeme(const token_type& t) const {
+    return input.lexeme(t.span.offset, t.span.length);
+  }
+
+  /**
+   * \brief Free the text of the tokens before t, whose lexemes can no
+   * longer be read.
+   */
+  void release_before(const token_type& t) {
+    input.release(t.span.offset);
+  }
+
+private:
+  regex& tokens;
+  regex* skipper;
+  std::vector<symbol_type> symbols;
+  symbol_type eoi;
+  CharInput& input;
+
+  token_type current;
+};
+
+#endif /* _REGEX_TOKEN_SOURCE_H_ */
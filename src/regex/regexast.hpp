@@ -1,13 +1,50 @@
 #ifndef _REGEXAST_H_
 #define _REGEXAST_H_
 
-#include <list>
 #include <iostream>
 #include <vector>
 #include <utility>
 
 #include "regex.hpp"
 
+class astRegexNode;
+
+/**
+ * \brief Glushkov automaton of a regex
+ *
+ * The positions are the leaves of the AST which match a character, numbered
+ * by getConfigurationSize. A configuration is the set of the positions which
+ * can match the next character, and its successor on a character is the
+ * union of the follow sets of its positions matching the character. These
+ * sets are computed by a single walk of the AST, so that the DFA
+ * construction only does set operations.
+ */
+struct RegexPositionAutomaton {
+  explicit RegexPositionAutomaton(astRegexNode* ast);
+
+  // The size of the configurations, whose last bit is the accepting one:
+  size_t configurationSize;
+
+  // The positions which can match the first character, and the ones whose
+  //  match completes the regex:
+  RegexConfiguration first;
+  RegexConfiguration last;
+
+  // For each position, the positions which can match the next character:
+  std::vector<RegexConfiguration> follow;
+
+  // For each character, the positions which match it:
+  std::vector<RegexConfiguration> matching;
+
+  // The delimited tokens, in the order their nodes were visited, which is
+  //  the priority order, and for each position, the first of them which it
+  //  completes, or tokenIds.size():
+  std::vector<size_t> tokenIds;
+  std::vector<size_t> tokenRanks;
+
+  void addToken(size_t tokenId, const RegexConfiguration& positions);
+};
+
 
 /**
  *
@@ -27,10 +64,13 @@ protected:
 protected:
   unsigned int nodeId;
 
-  void addToken(std::list< size_t >& tokens)
+  // Called by buildPositions, after the children, on the positions which
+  //  complete the node:
+  void addToken(RegexPositionAutomaton& automaton,
+                const RegexConfiguration& last) const
   {
     if(isDelimiter())
-      tokens.push_back(tokenId);
+      automaton.addToken(tokenId, last);
   }
 
   bool isDelimiter() const { return isRegexTokenDelimiter; }
@@ -39,11 +79,15 @@ public:
   astRegexNode(): isRegexTokenDelimiter(false), tokenId(0), nodeId(0) {}
   virtual ~astRegexNode(){}
   virtual unsigned int getConfigurationSize(unsigned int base) = 0;
-  virtual bool advance(const RegexConfiguration& conf,
-                       RegexConfiguration& succ,
-                       std::list< size_t >& accept,
-                       char c) = 0;
-  virtual bool setPred(RegexConfiguration& newConf) = 0;
+
+  // Compute the positions which can match the first character of the node,
+  //  the ones whose match completes it, and whether it matches the empty
+  //  string. The follow sets of the positions inside the node, and their
+  //  characters, are added to the automaton.
+  virtual void buildPositions(RegexPositionAutomaton& automaton,
+                              RegexConfiguration& first,
+                              RegexConfiguration& last,
+                              bool& nullable) const = 0;
 
   void setDelimiter(size_t delimiterTokenId)
   { isRegexTokenDelimiter = true; tokenId = delimiterTokenId; }
@@ -78,36 +122,28 @@ public:
     nodeId = base;
     return 1;
   }
-  virtual bool advance(const RegexConfiguration& conf,
-		       RegexConfiguration&, // newConf
-		       std::list< size_t >& accept,
-		       char s)
+  virtual void buildPositions(RegexPositionAutomaton& automaton,
+                              RegexConfiguration& first,
+                              RegexConfiguration& last,
+                              bool& nullable) const
   {
-    if(conf[nodeId])
+    for(char s(0); s < static_cast<char>(regexAlphabetSize); ++s)
       {
 	bool inRange(false);
 	for(unsigned int i(0); i < ranges.size(); ++i)
 	  if(s >= ranges[i].first && s <= ranges[i].second)
 	    inRange = true;
 
-	if(invert)
-	  inRange = !inRange;
-    
-	if(inRange)
-	  {
-	    addToken(accept);
-	    return true;
-	  }
+	if(inRange != invert)
+	  automaton.matching[s].set(nodeId);
       }
-    return false;
-  }
 
-  virtual bool setPred(RegexConfiguration& newConf)
-  {
-    newConf[nodeId] = true;
-    return false;
+    first.set(nodeId);
+    last.set(nodeId);
+    nullable = false;
+    addToken(automaton, last);
   }
-  
+
   virtual void enumerate(std::ostream& flux, unsigned int level) const
   {
     astRegexNode::enumerate(flux, level);
@@ -136,24 +172,18 @@ public:
     return 1;
   }
 
-  virtual bool advance(const RegexConfiguration& conf,
-                       RegexConfiguration&,
-                       std::list< size_t >& accept,
-                       char s)
-  { 
-    if((s == c) and conf[nodeId])
-      {
-        addToken(accept);
-        return true;
-      }
-    else
-      return false;
-  }
+  virtual void buildPositions(RegexPositionAutomaton& automaton,
+                              RegexConfiguration& first,
+                              RegexConfiguration& last,
+                              bool& nullable) const
+  {
+    if(static_cast<unsigned char>(c) < regexAlphabetSize)
+      automaton.matching[c].set(nodeId);
 
-  virtual bool setPred(RegexConfiguration& newConf)
-  { 
-    newConf[nodeId] = true;
-    return false;
+    first.set(nodeId);
+    last.set(nodeId);
+    nullable = false;
+    addToken(automaton, last);
   }
 
   virtual void enumerate(std::ostream& flux, unsigned int level) const
@@ -179,18 +209,15 @@ public:
     nodeId = base;
     return 1;
   }
-  virtual bool advance(const RegexConfiguration&, // oldconf
-		       RegexConfiguration&, // newconf
-		       std::list< size_t >&,
-		       char )
+  virtual void buildPositions(RegexPositionAutomaton& automaton,
+                              RegexConfiguration&, // first
+                              RegexConfiguration& last,
+                              bool& nullable) const
   {
-    return false;
-  }
-  virtual bool setPred(RegexConfiguration& newConf)
-  { 
-    newConf[nodeId] = true;
-    return true; 
+    nullable = true;
+    addToken(automaton, last);
   }
+
   virtual void enumerate(std::ostream& flux, unsigned int level) const
   {
     astRegexNode::enumerate(flux, level);
@@ -224,29 +251,24 @@ public:
     return s1 + s2;
   }
 
-  virtual bool advance(const RegexConfiguration& conf,
-                       RegexConfiguration& succ,
-                       std::list< size_t >& accept,
-                       char s)
+  virtual void buildPositions(RegexPositionAutomaton& automaton,
+                              RegexConfiguration& first,
+                              RegexConfiguration& last,
+                              bool& nullable) const
   {
-    bool r(false);
-    if(left->advance(conf, succ, accept, s))
-      r = right->setPred(succ);
-    if(right->advance(conf, succ, accept, s))
-      r = true;
-
-    if(r)
-      addToken(accept);
-
-    return r;
-  }
-
-  virtual bool setPred(RegexConfiguration& newConf)
-  { 
-    if(left->setPred(newConf))
-      if(right->setPred(newConf))
-	return true; 
-    return false;
+    RegexConfiguration rightFirst(first.size()), leftLast(last.size());
+    bool leftNullable(false), rightNullable(false);
+    left->buildPositions(automaton, first, leftLast, leftNullable);
+    right->buildPositions(automaton, rightFirst, last, rightNullable);
+
+    leftLast.for_each([&](size_t position) { automaton.follow[position] |= rightFirst; });
+    if(leftNullable)
+      first |= rightFirst;
+    if(rightNullable)
+      last |= leftLast;
+
+    nullable = leftNullable and rightNullable;
+    addToken(automaton, last);
   }
 
   virtual void enumerate(std::ostream& flux, unsigned int level) const
@@ -285,25 +307,20 @@ public:
     return s1 + s2;
   }
 
-  virtual bool advance(const RegexConfiguration& conf,
-                       RegexConfiguration& succ,
-                       std::list< size_t >& accept,
-                       char s)
-  { 
-    bool l(left->advance(conf, succ, accept, s));
-    bool r(right->advance(conf, succ, accept, s));
-
-    if(l or r)
-      addToken(accept);
-
-    return l or r;
-  }
-
-  virtual bool setPred(RegexConfiguration& newConf)
-  { 
-    bool l(left->setPred(newConf));
-    bool r(right->setPred(newConf));
-    return l or r;
+  virtual void buildPositions(RegexPositionAutomaton& automaton,
+                              RegexConfiguration& first,
+                              RegexConfiguration& last,
+                              bool& nullable) const
+  {
+    RegexConfiguration rightFirst(first.size()), rightLast(last.size());
+    bool leftNullable(false), rightNullable(false);
+    left->buildPositions(automaton, first, last, leftNullable);
+    right->buildPositions(automaton, rightFirst, rightLast, rightNullable);
+
+    first |= rightFirst;
+    last |= rightLast;
+    nullable = leftNullable or rightNullable;
+    addToken(automaton, last);
   }
 
   virtual void enumerate(std::ostream& flux, unsigned int level) const
@@ -322,35 +339,10 @@ public:
  */
 class astRegexAltTopLevel: public astRegexAlt
 {
-  unsigned int size;
 public:
-  astRegexAltTopLevel(astRegexNode* l, astRegexNode* r): astRegexAlt(l, r), size(0) {}
+  astRegexAltTopLevel(astRegexNode* l, astRegexNode* r): astRegexAlt(l, r) {}
   virtual ~astRegexAltTopLevel(){}
 
-  virtual unsigned int getConfigurationSize(unsigned int base)
-  {
-    nodeId = base;
-    unsigned int s1(left->getConfigurationSize(base));
-    unsigned int s2(right->getConfigurationSize(base + s1));
-    size = s1 + s2;
-    return s1 + s2 + 2;
-  }
-  virtual bool advance(const RegexConfiguration& conf,
-                       RegexConfiguration& succ,
-                       std::list< size_t >& accept,
-                       char s)
-  {
-    bool l(left->advance(conf, succ, accept, s));
-    bool r(right->advance(conf, succ, accept, s));
-
-    if(l) succ[nodeId+size]     = true;
-    if(r) succ[nodeId+size+1]   = true;
-
-    if(l or r)
-      addToken(accept);
-
-    return l or r;
-  }
   virtual astRegexNode* clone() const { return new astRegexAltTopLevel(*this); }
 };
 
@@ -375,24 +367,16 @@ public:
     return child->getConfigurationSize(base);
   }
 
-  virtual bool advance(const RegexConfiguration& conf,
-                       RegexConfiguration& succ,
-                       std::list< size_t >& accept,
-                       char s)
-  { 
-    if(child->advance(conf, succ, accept, s))
-      {
-	child->setPred(succ);
-        addToken(accept);
-	return true;
-      }
-    return false;
-  }
-
-  virtual bool setPred(RegexConfiguration& newConf)
+  virtual void buildPositions(RegexPositionAutomaton& automaton,
+                              RegexConfiguration& first,
+                              RegexConfiguration& last,
+                              bool& nullable) const
   {
-    child->setPred(newConf);
-    return true;
+    child->buildPositions(automaton, first, last, nullable);
+
+    last.for_each([&](size_t position) { automaton.follow[position] |= first; });
+    nullable = true;
+    addToken(automaton, last);
   }
 
   virtual void enumerate(std::ostream& flux, unsigned int level) const
@@ -86,9 +86,11 @@ class LexerBase {
     using namespace regexSymbols;
 
     unsigned int token_id(0);
+    std::size_t skipped(0);
+    if (match_regex_length(*skipper_regex_dfa, char_input, skipped, token_id))
+      char_input.skip(skipped);
+
     std::string buffer;
-    match_regex_longest(*skipper_regex_dfa, char_input, buffer, token_id);
-    buffer.clear();
 
     if (not char_input.good()) {
       current_symbol = Symbol::EOI;
@@ -149,6 +151,28 @@ class LexerBase {
   const Symbol& operator*() const { return current_symbol; }
   
   const std::string& value() const { return current_value; }
+
+  // Write the compiled token and skipper DFAs, as the classes name_tokens and
+  //  name_skipper, and the symbol of each token id as the array
+  //  name_token_symbols, in a C++ header. symbolId gives the integer written
+  //  for each symbol.
+  template<typename function_type>
+  void writeTables(std::ostream& flux,
+                   const std::string& name,
+                   function_type symbolId) const {
+    if (not token_regex_dfa or not skipper_regex_dfa)
+      throw std::string("LexerBase::writeTables() - "
+                        "The lexer is not compiled.");
+
+    writeRegexTables(flux, *token_regex_dfa, name + "_tokens");
+    writeRegexTables(flux, *skipper_regex_dfa, name + "_skipper");
+
+    // Token ids start at 1:
+    flux << "\nconstexpr unsigned int " << name << "_token_symbols[] = {\n    0,";
+    for (unsigned int i(0); i < token_symbols.size(); ++i)
+      flux << " " << symbolId(token_symbols[i]) << ",";
+    flux << "\n};\n";
+  }
 };
 
 
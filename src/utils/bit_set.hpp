@@ -0,0 +1,169 @@
+#ifndef _BIT_SET_H_
+#define _BIT_SET_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+
+/**
+ * \brief Dense set of small integers, stored as an array of machine words.
+ *
+ * The size of the set (the number of representable elements) is fixed at
+ * construction, or changed explicitly through \c resize. The binary set
+ * operations expect both operands to have the same size.
+ */
+class bit_set {
+public:
+  typedef std::uint64_t word_type;
+  static const std::size_t word_bits = 64;
+  static const std::size_t npos = static_cast<std::size_t>(-1);
+
+  bit_set(): bit_count(0), words() {}
+  explicit bit_set(std::size_t n): bit_count(n), words(word_count(n), 0) {}
+
+  std::size_t size() const { return bit_count; }
+
+  void resize(std::size_t n) {
+    bit_count = n;
+    words.resize(word_count(n), 0);
+    clear_padding();
+  }
+
+  bool test(std::size_t i) const {
+    return (words[i / word_bits] >> (i % word_bits)) & 1u;
+  }
+
+  void set(std::size_t i) { words[i / word_bits] |= word_type(1) << (i % word_bits); }
+  void reset(std::size_t i) { words[i / word_bits] &= ~(word_type(1) << (i % word_bits)); }
+  void clear() { std::fill(words.begin(), words.end(), 0); }
+
+  bool any() const {
+    for (const auto w: words)
+      if (w)
+        return true;
+    return false;
+  }
+  bool none() const { return not any(); }
+
+  std::size_t count() const {
+    std::size_t n(0);
+    for (const auto w: words)
+      n += __builtin_popcountll(w);
+    return n;
+  }
+
+  bit_set& operator|=(const bit_set& op) {
+    for (std::size_t i(0); i < words.size(); ++i)
+      words[i] |= op.words[i];
+    return *this;
+  }
+
+  bit_set& operator&=(const bit_set& op) {
+    for (std::size_t i(0); i < words.size(); ++i)
+      words[i] &= op.words[i];
+    return *this;
+  }
+
+  /**
+   * \brief Remove the elements of \c op from this set.
+   */
+  bit_set& subtract(const bit_set& op) {
+    for (std::size_t i(0); i < words.size(); ++i)
+      words[i] &= ~op.words[i];
+    return *this;
+  }
+
+  /**
+   * \brief Union with \c op, returning true if this set has grown.
+   *
+   * This is the primitive of the fixed-point and worklist algorithms, which
+   * only have to revisit a set when it actually changed.
+   */
+  bool merge(const bit_set& op) {
+    word_type changed(0);
+    for (std::size_t i(0); i < words.size(); ++i) {
+      const word_type w(words[i] | op.words[i]);
+      changed |= w ^ words[i];
+      words[i] = w;
+    }
+    return changed != 0;
+  }
+
+  bool intersects(const bit_set& op) const {
+    for (std::size_t i(0); i < words.size(); ++i)
+      if (words[i] & op.words[i])
+        return true;
+    return false;
+  }
+
+  /**
+   * \brief Smallest element greater or equal to \c i, or \c npos.
+   */
+  std::size_t find_next(std::size_t i) const {
+    if (i >= bit_count)
+      return npos;
+
+    std::size_t w(i / word_bits);
+    word_type bits(words[w] & (~word_type(0) << (i % word_bits)));
+    while (not bits) {
+      if (++w == words.size())
+        return npos;
+      bits = words[w];
+    }
+    return w * word_bits + __builtin_ctzll(bits);
+  }
+  std::size_t find_first() const { return find_next(0); }
+
+  /**
+   * \brief Call \c f on each element of the set, in increasing order.
+   */
+  template<typename function_type>
+  void for_each(function_type f) const {
+    for (std::size_t w(0); w < words.size(); ++w) {
+      word_type bits(words[w]);
+      while (bits) {
+        f(w * word_bits + __builtin_ctzll(bits));
+        bits &= bits - 1;
+      }
+    }
+  }
+
+  std::size_t hash() const {
+    std::size_t h(bit_count);
+    for (const auto w: words)
+      h ^= static_cast<std::size_t>(w * 0x9e3779b97f4a7c15ull) + (h << 6) + (h >> 2);
+    return h;
+  }
+
+  const std::vector<word_type>& data() const { return words; }
+
+  friend bool operator==(const bit_set& op1, const bit_set& op2) {
+    return op1.bit_count == op2.bit_count and op1.words == op2.words;
+  }
+  friend bool operator!=(const bit_set& op1, const bit_set& op2) {
+    return not (op1 == op2);
+  }
+  friend bool operator<(const bit_set& op1, const bit_set& op2) {
+    return op1.bit_count == op2.bit_count
+      ? op1.words < op2.words
+      : op1.bit_count < op2.bit_count;
+  }
+
+private:
+  std::size_t bit_count;
+  std::vector<word_type> words;
+
+  static std::size_t word_count(std::size_t n) { return (n + word_bits - 1) / word_bits; }
+
+  void clear_padding() {
+    if (bit_count % word_bits)
+      words.back() &= ~(~word_type(0) << (bit_count % word_bits));
+  }
+};
+
+struct bit_set_hash {
+  std::size_t operator()(const bit_set& s) const { return s.hash(); }
+};
+
+#endif /* _BIT_SET_H_ */
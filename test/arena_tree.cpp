@@ -0,0 +1,94 @@
+#include "../src/parser/parse_input.hpp"
+#include "../src/parser/parse_tree.hpp"
+#include "../src/parser/token_view.hpp"
+
+enum class symbol { start, eoi, number, comma, number_list };
+
+std::ostream& operator<<(std::ostream& stream, const symbol& s) {
+  switch (s) {
+  case symbol::start: stream << "<start>"; break;
+  case symbol::eoi: stream << "<eoi>"; break;
+  case symbol::number: stream << "<number>"; break;
+  case symbol::comma: stream << "<comma>"; break;
+  case symbol::number_list: stream << "<number_list>"; break;
+  }
+  return stream;
+}
+
+using token_type = token_view<symbol>;
+
+/*
+ * Tokens of the list "0,1,...,n-1": each number is one character long.
+ */
+class list_token_source {
+public:
+  using symbol_type = symbol;
+  using token_type = ::token_type;
+
+  list_token_source(std::size_t numbers): numbers(numbers), current{symbol::number, {0, 1}, 0, 0} {}
+
+  const token_type& get() const { return current; }
+
+  void next() {
+    current.span.offset += current.span.length;
+    current.column = current.span.offset;
+    if (current.span.offset >= 2 * numbers - 1)
+      current.symbol = symbol::eoi;
+    else
+      current.symbol = current.symbol == symbol::number ? symbol::comma : symbol::number;
+  }
+
+private:
+  std::size_t numbers;
+  token_type current;
+};
+
+void show(const parse_tree::arena_tree<token_type>& tree,
+          const parse_tree::arena_node<token_type>& n,
+          unsigned int level = 0) {
+  std::cout << std::string(level, ' ') << n.index << ": " << n.symbol;
+  if (n.is_terminal())
+    std::cout << " at " << n.token.span.offset;
+  std::cout << std::endl;
+
+  for (std::size_t i(0); i < n.child_count; ++i)
+    show(tree, tree.child(n, i), level + 2);
+}
+
+int main() {
+  try {
+    cf_grammar<symbol> g(symbol::start);
+    g.add_production(symbol::start, {symbol::number_list, symbol::eoi});
+    g.add_production(symbol::number_list, {symbol::number});
+    g.add_production(symbol::number_list, {symbol::number, symbol::comma, symbol::number_list});
+
+    g.wrap_up();
+
+    lr_parser<symbol> p(g);
+
+    parse_tree::arena_tree<token_type> tree(16);
+    parse_tree::arena_tree_factory<token_type> factory(tree);
+
+    list_token_source tokens(3);
+    show(tree, *parse_input_to_tree(p, tokens, factory));
+
+    // The blocks are reused by the next tree:
+    tree.clear();
+    list_token_source long_tokens(100000);
+    const parse_tree::arena_node<token_type>* root(parse_input_to_tree(p, long_tokens, factory));
+
+    // The children of each production are created before it:
+    bool post_order(true);
+    for (std::size_t i(0); i < tree.size(); ++i)
+      for (std::size_t j(0); j < tree[i].child_count; ++j)
+        post_order = post_order and tree.child(tree[i], j).index < i;
+
+    std::cout << tree.size() << " nodes, root " << root->index
+              << (post_order ? ", in post-order" : ", not in post-order") << std::endl;
+  }
+  catch (const std::string& e) {
+    std::cout << e << std::endl;
+  }
+
+  return 0;
+}
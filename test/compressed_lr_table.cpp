@@ -0,0 +1,162 @@
+#include "../src/parser/parse_input.hpp"
+
+/*
+ * The arithmetic expression grammar, with its chains of unit productions:
+ *  start = expr eoi
+ *  expr = expr plus term | term
+ *  term = term times factor | factor
+ *  factor = number | lparen expr rparen
+ */
+enum class symbol { start, eoi, number, plus, times, lparen, rparen, expr, term, factor };
+
+std::ostream& operator<<(std::ostream& stream, const symbol& s) {
+  switch (s) {
+  case symbol::start: stream << "<start>"; break;
+  case symbol::eoi: stream << "<eoi>"; break;
+  case symbol::number: stream << "<number>"; break;
+  case symbol::plus: stream << "<plus>"; break;
+  case symbol::times: stream << "<times>"; break;
+  case symbol::lparen: stream << "<lparen>"; break;
+  case symbol::rparen: stream << "<rparen>"; break;
+  case symbol::expr: stream << "<expr>"; break;
+  case symbol::term: stream << "<term>"; break;
+  case symbol::factor: stream << "<factor>"; break;
+  }
+  return stream;
+}
+
+template<typename s_type>
+struct dummy_token {
+  using symbol_type = s_type;
+
+  symbol_type symbol;
+
+  std::string render_coordinates() const { return ""; }
+  dummy_token* copy() const { return new dummy_token(*this); }
+};
+
+class dummy_token_source {
+public:
+  using symbol_type = symbol;
+  using token_type = dummy_token<symbol_type>;
+
+  dummy_token_source(const std::vector<symbol_type>& symbols): tokens(), current(0) {
+    for (const auto& s: symbols)
+      tokens.push_back(token_type{s});
+  }
+
+  const token_type& get() const { return tokens[current]; }
+  void next() { ++current; }
+
+private:
+  std::vector<token_type> tokens;
+  std::size_t current;
+};
+
+struct node {
+  symbol s;
+  std::vector<node*> children;
+
+  ~node() {
+    for (auto child: children)
+      delete child;
+  }
+
+  void show(std::ostream& stream) const {
+    stream << s;
+    if (not children.empty()) {
+      stream << "(";
+      for (const auto child: children)
+        child->show(stream);
+      stream << ")";
+    }
+  }
+};
+
+/*
+ * Count the reductions performed by the parse functions.
+ */
+class counting_tree_factory {
+public:
+  using node_type = node;
+
+  counting_tree_factory(): reductions(0) {}
+
+  template<typename iterator_type>
+  node_type* build_node(iterator_type begin, iterator_type end, unsigned int, symbol s) {
+    ++reductions;
+    return new node{s, std::vector<node*>(begin, end)};
+  }
+
+  node_type* build_leaf(const dummy_token_source& input) {
+    return new node{input.get().symbol, {}};
+  }
+
+  std::size_t reductions;
+};
+
+// Parse the input, and return the number of reductions performed:
+template<typename table_type>
+std::size_t parse(const std::string& name, const table_type& table, const std::vector<symbol>& input) {
+  dummy_token_source tokens(input);
+  counting_tree_factory factory;
+  node* tree(parse_input_to_tree<dummy_token_source, counting_tree_factory>(table, tokens, factory));
+
+  std::cout << name << ": " << factory.reductions << " reductions" << std::endl;
+  tree->show(std::cout);
+  std::cout << std::endl;
+  delete tree;
+  return factory.reductions;
+}
+
+int main() {
+  try {
+    cf_grammar<symbol> g(symbol::start);
+    g.add_production(symbol::start, {symbol::expr, symbol::eoi});
+    g.add_production(symbol::expr, {symbol::expr, symbol::plus, symbol::term});
+    g.add_production(symbol::expr, {symbol::term});
+    g.add_production(symbol::term, {symbol::term, symbol::times, symbol::factor});
+    g.add_production(symbol::term, {symbol::factor});
+    g.add_production(symbol::factor, {symbol::number});
+    g.add_production(symbol::factor, {symbol::lparen, symbol::expr, symbol::rparen});
+
+    g.wrap_up();
+
+    lr_parser<symbol> p(g, lookahead_method::lalr);
+    const std::vector<symbol> input({symbol::number, symbol::times, symbol::lparen,
+          symbol::number, symbol::plus, symbol::number, symbol::rparen, symbol::eoi});
+
+    const packed_lr_table<symbol> packed(p);
+    parse("packed table", packed, input);
+
+    const compressed_lr_table<symbol> compressed(p);
+    const std::size_t reductions(parse("compressed table", compressed, input));
+
+    table_options options;
+    options.unit_rule_elimination = true;
+    const compressed_lr_table<symbol> bypassed(p, options);
+    std::cout << "table entries bypassing unit reductions, by chain length: "
+              << bypassed.eliminated_unit_reductions() << std::endl;
+    const std::size_t bypassed_reductions(parse("unit rule elimination", bypassed, input));
+    std::cout << "unit reductions eliminated from the parse: "
+              << reductions - bypassed_reductions << std::endl;
+    if (bypassed_reductions >= reductions)
+      std::cout << "unit rule elimination saved no reduction" << std::endl;
+
+    // factor = number keeps its node:
+    options.semantic_productions.insert(5);
+    const compressed_lr_table<symbol> partially_bypassed(p, options);
+    parse("unit rule elimination except factor = number", partially_bypassed, input);
+
+    dummy_token_source invalid_tokens({symbol::number, symbol::plus, symbol::rparen, symbol::eoi});
+    if (parse_input(bypassed, invalid_tokens))
+      std::cout << "invalid input accepted" << std::endl;
+    else
+      std::cout << "invalid input rejected" << std::endl;
+  }
+  catch (const std::string& e) {
+    std::cout << e << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,147 @@
+#include "../src/parser/error_recovery.hpp"
+#include "../src/parser/parse_tree.hpp"
+
+/*
+ * A list of statements, which resynchronizes on the semicolons:
+ *  start = statements eoi
+ *  statements = statements statement | statement
+ *  statement = number semicolon | error semicolon
+ */
+enum class symbol { start, eoi, number, semicolon, error, statements, statement };
+
+std::ostream& operator<<(std::ostream& stream, const symbol& s) {
+  switch (s) {
+  case symbol::start: stream << "<start>"; break;
+  case symbol::eoi: stream << "<eoi>"; break;
+  case symbol::number: stream << "<number>"; break;
+  case symbol::semicolon: stream << "<semicolon>"; break;
+  case symbol::error: stream << "<error>"; break;
+  case symbol::statements: stream << "<statements>"; break;
+  case symbol::statement: stream << "<statement>"; break;
+  }
+  return stream;
+}
+
+template<typename s_type>
+struct dummy_token {
+  using symbol_type = s_type;
+
+  symbol_type symbol;
+  unsigned int position;
+
+  std::string render_coordinates() const { return "token " + std::to_string(position); }
+  dummy_token* copy() const { return new dummy_token(*this); }
+};
+
+using token_type = dummy_token<symbol>;
+using tree_factory = parse_tree::tree_factory<token_type>;
+
+class dummy_token_source {
+public:
+  using symbol_type = symbol;
+  using token_type = ::token_type;
+
+  dummy_token_source(const std::vector<symbol_type>& symbols): tokens(), current(0) {
+    for (const auto& s: symbols)
+      tokens.push_back(token_type{s, static_cast<unsigned int>(tokens.size())});
+  }
+
+  const token_type& get() const { return tokens[current]; }
+  void next() { ++current; }
+
+private:
+  std::vector<token_type> tokens;
+  std::size_t current;
+};
+
+class show_visitor: public parse_tree::basic_visitor<token_type> {
+public:
+  show_visitor(): level(0) {}
+
+  void visit(parse_tree::terminal<token_type>* t) {
+    std::cout << std::string(level, ' ') << t->token().symbol
+              << " at " << t->token().render_coordinates() << std::endl;
+  }
+
+  void visit(parse_tree::production<token_type>* p) {
+    std::cout << std::string(level, ' ') << p->symbol();
+    if (p->production_id() == error_production_id)
+      std::cout << " (recovered)";
+    std::cout << std::endl;
+    level += 2;
+    for (const auto& c: p->get_children())
+      c->accept(this);
+    level -= 2;
+  }
+
+private:
+  unsigned int level;
+};
+
+void parse(const packed_lr_table<symbol>& table, const std::vector<symbol>& symbols) {
+  dummy_token_source input(symbols);
+  tree_factory factory;
+  std::vector<parse_diagnostic<token_type> > diagnostics;
+
+  parse_tree::node<token_type>* tree(parse_input_to_tree_with_recovery(table, input, factory,
+                                                                       symbol::error, symbol::eoi,
+                                                                       diagnostics));
+  for (const auto& d: diagnostics) {
+    std::cout << "syntax error near " << d.unexpected_token.render_coordinates() << ", expected:";
+    for (const auto& s: d.expected_symbols)
+      std::cout << " " << s;
+    std::cout << std::endl;
+  }
+
+  show_visitor v;
+  tree->accept(&v);
+  delete tree;
+  std::cout << std::endl;
+}
+
+int main() {
+  try {
+    cf_grammar<symbol> g(symbol::start);
+    g.add_production(symbol::start, {symbol::statements, symbol::eoi});
+    g.add_production(symbol::statements, {symbol::statements, symbol::statement});
+    g.add_production(symbol::statements, {symbol::statement});
+    g.add_production(symbol::statement, {symbol::number, symbol::semicolon});
+    g.add_production(symbol::statement, {symbol::error, symbol::semicolon});
+
+    g.wrap_up();
+
+    lr_parser<symbol> p(g, lookahead_method::lalr);
+    const packed_lr_table<symbol> table(p);
+
+    // A valid input is parsed as by parse_input_to_tree:
+    parse(table, {symbol::number, symbol::semicolon, symbol::eoi});
+
+    // Each statement is recovered on its own, and the errors are all reported:
+    parse(table, {symbol::number, symbol::number, symbol::semicolon,
+                  symbol::number, symbol::semicolon,
+                  symbol::semicolon,
+                  symbol::number, symbol::semicolon, symbol::eoi});
+
+    // An input which cannot be recovered is returned under an error node:
+    parse(table, {symbol::number, symbol::semicolon, symbol::number, symbol::number, symbol::eoi});
+
+    // Without error productions, the unexpected tokens are skipped:
+    cf_grammar<symbol> h(symbol::start);
+    h.add_production(symbol::start, {symbol::statements, symbol::eoi});
+    h.add_production(symbol::statements, {symbol::statements, symbol::statement});
+    h.add_production(symbol::statements, {symbol::statement});
+    h.add_production(symbol::statement, {symbol::number, symbol::semicolon});
+
+    h.wrap_up();
+
+    lr_parser<symbol> q(h, lookahead_method::lalr);
+    const packed_lr_table<symbol> panic_table(q);
+    parse(panic_table, {symbol::number, symbol::semicolon, symbol::semicolon,
+                        symbol::number, symbol::semicolon, symbol::eoi});
+  }
+  catch (const std::string& e) {
+    std::cout << e << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,89 @@
+#include "../src/parser/parse_input.hpp"
+#include "../src/parser/token_view.hpp"
+
+enum class symbol { start, eoi, number, comma, number_list };
+
+std::ostream& operator<<(std::ostream& stream, const symbol& s) {
+  switch (s) {
+  case symbol::start: stream << "<start>"; break;
+  case symbol::eoi: stream << "<eoi>"; break;
+  case symbol::number: stream << "<number>"; break;
+  case symbol::comma: stream << "<comma>"; break;
+  case symbol::number_list: stream << "<number_list>"; break;
+  }
+  return stream;
+}
+
+using token_type = token_view<symbol>;
+using record_type = flat_tree_record<symbol>;
+
+/*
+ * Tokens of the list "0,1,...,n-1": each number is one character long.
+ */
+class list_token_source {
+public:
+  using symbol_type = symbol;
+  using token_type = ::token_type;
+
+  list_token_source(std::size_t numbers): numbers(numbers), current{symbol::number, {0, 1}, 0, 0} {}
+
+  const token_type& get() const { return current; }
+
+  void next() {
+    current.span.offset += current.span.length;
+    current.column = current.span.offset;
+    if (current.span.offset >= 2 * numbers - 1)
+      current.symbol = symbol::eoi;
+    else
+      current.symbol = current.symbol == symbol::number ? symbol::comma : symbol::number;
+  }
+
+private:
+  std::size_t numbers;
+  token_type current;
+};
+
+void show(const flat_tree_cursor<symbol>& c, unsigned int level = 0) {
+  std::cout << std::string(level, ' ') << c.get_index() << ": " << c->symbol
+            << " [" << c->span.offset << ", " << c->span.offset + c->span.length << ")" << std::endl;
+
+  for (std::size_t i(0); i < c.child_count(); ++i)
+    show(c.child(i), level + 2);
+}
+
+int main() {
+  try {
+    cf_grammar<symbol> g(symbol::start);
+    g.add_production(symbol::start, {symbol::number_list, symbol::eoi});
+    g.add_production(symbol::number_list, {symbol::number});
+    g.add_production(symbol::number_list, {symbol::number, symbol::comma, symbol::number_list});
+
+    g.wrap_up();
+
+    lr_parser<symbol> p(g);
+
+    std::vector<record_type> records;
+    list_token_source tokens(3);
+    parse_input_to_flat_tree(p, tokens, records);
+
+    for (const auto& r: records)
+      std::cout << r.symbol << " " << (r.is_terminal() ? std::string("shift") : "reduce " + std::to_string(r.production_id))
+                << " children " << r.child_count << " size " << r.size << std::endl;
+
+    show(flat_tree_cursor<symbol>(records));
+
+    // The buffer is reused by the next parse:
+    const packed_lr_table<symbol> packed(p);
+    list_token_source more_tokens(2);
+    const record_type* data(records.data());
+    parse_input_to_flat_tree(packed, more_tokens, records);
+
+    show(flat_tree_cursor<symbol>(records));
+    std::cout << (records.data() == data ? "buffer reused" : "buffer reallocated") << std::endl;
+  }
+  catch (const std::string& e) {
+    std::cout << e << std::endl;
+  }
+
+  return 0;
+}
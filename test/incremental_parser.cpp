@@ -0,0 +1,117 @@
+#include "../src/parser/incremental_parser.hpp"
+
+/*
+ * A left recursive list, whose prefix before an edit is reused as a whole:
+ *  start = list eoi
+ *  list = list comma number | number
+ */
+enum class symbol { start, eoi, number, comma, list };
+
+std::ostream& operator<<(std::ostream& stream, const symbol& s) {
+  switch (s) {
+  case symbol::start: stream << "<start>"; break;
+  case symbol::eoi: stream << "<eoi>"; break;
+  case symbol::number: stream << "<number>"; break;
+  case symbol::comma: stream << "<comma>"; break;
+  case symbol::list: stream << "<list>"; break;
+  }
+  return stream;
+}
+
+template<typename s_type>
+struct dummy_token {
+  using symbol_type = s_type;
+
+  symbol_type symbol;
+  int value;
+
+  std::string render_coordinates() const { return std::to_string(value); }
+  dummy_token* copy() const { return new dummy_token(*this); }
+};
+
+using token_type = dummy_token<symbol>;
+using parser_type = incremental_parser<packed_lr_table<symbol>, token_type>;
+
+void show(std::ostream& stream, const parser_type::node_type* n) {
+  if (n->is_terminal()) {
+    if (n->symbol == symbol::number)
+      stream << n->token.value;
+    else if (n->symbol == symbol::comma)
+      stream << ",";
+    return;
+  }
+
+  stream << "(";
+  for (const auto c: n->children)
+    show(stream, c);
+  stream << ")";
+}
+
+// The tokens "0,1,...,n-1":
+std::vector<token_type> list(int n) {
+  std::vector<token_type> tokens;
+  for (int i(0); i < n; ++i) {
+    if (i > 0)
+      tokens.push_back(token_type{symbol::comma, 0});
+    tokens.push_back(token_type{symbol::number, i});
+  }
+  return tokens;
+}
+
+int main() {
+  try {
+    cf_grammar<symbol> g(symbol::start);
+    g.add_production(symbol::start, {symbol::list, symbol::eoi});
+    g.add_production(symbol::list, {symbol::list, symbol::comma, symbol::number});
+    g.add_production(symbol::list, {symbol::number});
+
+    g.wrap_up();
+
+    lr_parser<symbol> p(g);
+    const packed_lr_table<symbol> table(p);
+    parser_type parser(table, g.start_symbol);
+
+    std::vector<token_type> tokens(list(6));
+    tokens.push_back(token_type{symbol::eoi, 0});
+    show(std::cout, parser.parse(tokens));
+    std::cout << std::endl;
+
+    // Insert ",10,11" after 2, at token 5:
+    show(std::cout, parser.reparse(5, 5, {{symbol::comma, 0}, {symbol::number, 10},
+            {symbol::comma, 0}, {symbol::number, 11}}));
+    std::cout << ", " << parser.reused_subtrees() << " subtrees reused" << std::endl;
+
+    // Replace 4 by 12:
+    show(std::cout, parser.reparse(12, 13, {{symbol::number, 12}}));
+    std::cout << ", " << parser.reused_subtrees() << " subtrees reused" << std::endl;
+
+    // Remove "0," at the beginning:
+    show(std::cout, parser.reparse(0, 2, {}));
+    std::cout << ", " << parser.reused_subtrees() << " subtrees reused" << std::endl;
+
+    // An invalid edit keeps the previous tree:
+    try {
+      parser.reparse(1, 2, {});
+    }
+    catch (const parse_error<token_type>& e) {
+      std::cout << "parse error near " << e.get_unexpected_token().render_coordinates() << ", expected:";
+      for (const auto& s: e.get_expected_symbols())
+        std::cout << " " << s;
+      std::cout << std::endl;
+    }
+    show(std::cout, parser.tree());
+    std::cout << std::endl;
+
+    // An edit at the end of a long list reuses its prefix:
+    std::vector<token_type> long_tokens(list(100000));
+    long_tokens.push_back(token_type{symbol::eoi, 0});
+    parser.parse(long_tokens);
+    parser.reparse(long_tokens.size() - 2, long_tokens.size() - 1, {{symbol::number, -1}});
+    std::cout << parser.tree()->width << " tokens, " << parser.reused_subtrees() << " subtrees reused" << std::endl;
+  }
+  catch (const std::string& e) {
+    std::cout << e << std::endl;
+  }
+
+  return 0;
+}
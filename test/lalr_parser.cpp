@@ -0,0 +1,90 @@
+#include "../src/parser/parse_input.hpp"
+
+/*
+ * The classic assignment grammar, which is LALR(1) but not SLR(1):
+ *  start = assign eoi
+ *  assign = lvalue equal rvalue | rvalue
+ *  lvalue = star rvalue | id
+ *  rvalue = lvalue
+ */
+enum class symbol { start, eoi, equal, star, id, assign, lvalue, rvalue };
+
+std::ostream& operator<<(std::ostream& stream, const symbol& s) {
+  switch (s) {
+  case symbol::start: stream << "<start>"; break;
+  case symbol::eoi: stream << "<eoi>"; break;
+  case symbol::equal: stream << "<equal>"; break;
+  case symbol::star: stream << "<star>"; break;
+  case symbol::id: stream << "<id>"; break;
+  case symbol::assign: stream << "<assign>"; break;
+  case symbol::lvalue: stream << "<lvalue>"; break;
+  case symbol::rvalue: stream << "<rvalue>"; break;
+  }
+  return stream;
+}
+
+template<typename s_type>
+struct dummy_token {
+  using symbol_type = s_type;
+
+  symbol_type symbol;
+
+  std::string render_coordinates() const { return ""; }
+};
+
+template<typename symbol_t>
+class dummy_token_source {
+public:
+  using symbol_type = symbol_t;
+  using token_type = dummy_token<symbol_type>;
+
+  dummy_token_source(const std::vector<symbol_type>& symbols): tokens(), current(0) {
+    for (const auto& s: symbols)
+      tokens.push_back(token_type{s});
+  }
+
+  const token_type& get() const { return tokens[current]; }
+  void next() { ++current; }
+
+private:
+  std::vector<token_type> tokens;
+  std::size_t current;
+};
+
+void parse(lr_parser<symbol>& p, const std::string& name, const std::vector<symbol>& input) {
+  dummy_token_source<symbol> tokens(input);
+  std::cout << name << (parse_input(p, tokens) ? ": accepted" : ": rejected") << std::endl;
+}
+
+int main() {
+  cf_grammar<symbol> g(symbol::start);
+  g.add_production(symbol::start, {symbol::assign, symbol::eoi});
+  g.add_production(symbol::assign, {symbol::lvalue, symbol::equal, symbol::rvalue});
+  g.add_production(symbol::assign, {symbol::rvalue});
+  g.add_production(symbol::lvalue, {symbol::star, symbol::rvalue});
+  g.add_production(symbol::lvalue, {symbol::id});
+  g.add_production(symbol::rvalue, {symbol::lvalue});
+
+  g.wrap_up();
+
+  try {
+    lr_parser<symbol> p(g);
+    std::cout << "unexpected: the grammar is SLR(1)" << std::endl;
+    return 1;
+  }
+  catch (const std::string& e) {
+    std::cout << "SLR(1): " << e << std::endl;
+  }
+
+  lr_parser<symbol> p(g, lookahead_method::lalr);
+  p.print(std::cout, g);
+
+  // Once *id is reduced to lvalue, equal is ahead: SLR(1) cannot choose
+  // between shifting it and reducing rvalue = lvalue, since equal follows
+  // rvalue. The LALR(1) lookahead of this reduction is eoi only:
+  parse(p, "*id = id", {symbol::star, symbol::id, symbol::equal, symbol::id, symbol::eoi});
+  parse(p, "*id", {symbol::star, symbol::id, symbol::eoi});
+  parse(p, "id = = id", {symbol::id, symbol::equal, symbol::equal, symbol::id, symbol::eoi});
+
+  return 0;
+}
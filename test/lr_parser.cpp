@@ -1,6 +1,6 @@
-#include "../src/parser/lr_parser.hpp"
+#include "../src/parser/parse_input.hpp"
 
-enum class symbol { start, eoi, number, comma, number_list };
+enum class symbol { start, eoi, number, comma, number_list, optional_number_list };
 
 std::ostream& operator<<(std::ostream& stream, const symbol& s) {
   switch (s) {
@@ -9,10 +9,88 @@ std::ostream& operator<<(std::ostream& stream, const symbol& s) {
   case symbol::number: stream << "<number>"; break;
   case symbol::comma: stream << "<comma>"; break;
   case symbol::number_list: stream << "<number_list>"; break;
+  case symbol::optional_number_list: stream << "<optional_number_list>"; break;
   }
   return stream;
 }
 
+template<typename s_type>
+struct dummy_token {
+  using symbol_type = s_type;
+
+  symbol_type symbol;
+
+  std::string render_coordinates() const { return ""; }
+  dummy_token* copy() const { return new dummy_token(*this); }
+};
+
+template<typename symbol_t>
+class dummy_token_source {
+public:
+  using symbol_type = symbol_t;
+  using token_type = dummy_token<symbol_type>;
+
+  dummy_token_source(const std::vector<symbol_type>& symbols): tokens(), current(0) {
+    for (const auto& s: symbols)
+      tokens.push_back(token_type{s});
+  }
+
+  const token_type& get() const { return tokens[current]; }
+  void next() { ++current; }
+
+private:
+  std::vector<token_type> tokens;
+  std::size_t current;
+};
+
+struct node {
+  symbol s;
+  std::vector<node*> children;
+
+  ~node() {
+    for (auto c: children)
+      delete c;
+  }
+
+  void show(std::ostream& stream) const {
+    stream << s;
+    if (children.empty())
+      return;
+    stream << "(";
+    for (auto c: children)
+      c->show(stream);
+    stream << ")";
+  }
+};
+
+class tree_factory {
+public:
+  using node_type = node;
+
+  node_type* build_node(node_type** begin, node_type** end, unsigned int, symbol s) {
+    return new node{s, std::vector<node*>(begin, end)};
+  }
+
+  node_type* build_leaf(const dummy_token_source<symbol>& input) {
+    return new node{input.get().symbol, {}};
+  }
+};
+
+void parse(lr_parser<symbol>& p, const std::vector<symbol>& input) {
+  dummy_token_source<symbol> tokens(input);
+  if (not parse_input(p, tokens)) {
+    std::cout << "rejected" << std::endl;
+    return;
+  }
+
+  dummy_token_source<symbol> tree_tokens(input);
+  tree_factory factory;
+  node* tree(parse_input_to_tree(p, tree_tokens, factory));
+  tree->show(std::cout);
+  std::cout << std::endl;
+  delete tree;
+}
+
 int main() {
   cf_grammar<symbol> g(symbol::start);
   g.add_production(symbol::start, {symbol::number_list, symbol::eoi});
@@ -28,6 +106,24 @@ int main() {
   p.print_first_sets(std::cout);
   p.print_configuration_set(std::cout, g);
 
+  // The same list, which may now be empty:
+  cf_grammar<symbol> h(symbol::start);
+  h.add_production(symbol::start, {symbol::optional_number_list, symbol::eoi});
+  h.add_production(symbol::optional_number_list, {});
+  h.add_production(symbol::optional_number_list, {symbol::number_list});
+  h.add_production(symbol::number_list, {symbol::number});
+  h.add_production(symbol::number_list, {symbol::number, symbol::comma, symbol::number_list});
+
+  h.wrap_up();
+
+  lr_parser<symbol> q(h);
+  q.print(std::cout, h);
+
+  // The empty list is reduced from no symbol:
+  parse(q, {symbol::eoi});
+  parse(q, {symbol::number, symbol::comma, symbol::number, symbol::eoi});
+  parse(q, {symbol::number, symbol::comma, symbol::eoi});
+
   return 0;
 }
 
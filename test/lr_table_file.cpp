@@ -0,0 +1,114 @@
+#include <fstream>
+#include <cstdio>
+
+#include "../src/parser/parse_input.hpp"
+#include "../src/parser/mapped_lr_table.hpp"
+
+enum class symbol { start, eoi, number, comma, number_list };
+
+std::ostream& operator<<(std::ostream& stream, const symbol& s) {
+  switch (s) {
+  case symbol::start: stream << "<start>"; break;
+  case symbol::eoi: stream << "<eoi>"; break;
+  case symbol::number: stream << "<number>"; break;
+  case symbol::comma: stream << "<comma>"; break;
+  case symbol::number_list: stream << "<number_list>"; break;
+  }
+  return stream;
+}
+
+template<typename s_type>
+struct dummy_token {
+  using symbol_type = s_type;
+
+  symbol_type symbol;
+
+  std::string render_coordinates() const { return ""; }
+};
+
+template<typename symbol_t>
+class dummy_token_source {
+public:
+  using symbol_type = symbol_t;
+  using token_type = dummy_token<symbol_type>;
+
+  dummy_token_source(const std::vector<symbol_type>& symbols): tokens(), current(0) {
+    for (const auto& s: symbols)
+      tokens.push_back(token_type{s});
+  }
+
+  const token_type& get() const { return tokens[current]; }
+  void next() { ++current; }
+
+private:
+  std::vector<token_type> tokens;
+  std::size_t current;
+};
+
+int main() {
+  const std::string filename("test_lr_table_file.tables");
+
+  try {
+    cf_grammar<symbol> g(symbol::start);
+    g.add_production(symbol::start, {symbol::number_list, symbol::eoi});
+    g.add_production(symbol::number_list, {symbol::number});
+    g.add_production(symbol::number_list, {symbol::number, symbol::comma, symbol::number_list});
+
+    g.wrap_up();
+
+    lr_parser<symbol> p(g);
+    {
+      std::ofstream file(filename.c_str(), std::ios::out | std::ios::binary);
+      p.save(file, g);
+    }
+
+    std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+    lr_parser<symbol> loaded(lr_parser<symbol>::load(file, g));
+
+    if (loaded.transitions_table == p.transitions_table
+        and loaded.goto_table == p.goto_table
+        and loaded.accepting_state == p.accepting_state
+        and loaded.rule_lengths == p.rule_lengths
+        and loaded.reduce_symbol == p.reduce_symbol
+        and loaded.terminal_map == p.terminal_map
+        and loaded.non_terminal_map == p.non_terminal_map)
+      std::cout << "loaded tables are identical" << std::endl;
+    else
+      std::cout << "loaded tables differ" << std::endl;
+
+    const mapped_lr_table<symbol> mapped(filename, g);
+    dummy_token_source<symbol> tokens({symbol::number, symbol::comma, symbol::number, symbol::eoi});
+    if (parse_input(mapped, tokens))
+      std::cout << "mapped table parse succeed" << std::endl;
+    else
+      std::cout << "mapped table parse failed" << std::endl;
+
+    dummy_token_source<symbol> invalid_tokens({symbol::number, symbol::comma, symbol::eoi});
+    if (parse_input(mapped, invalid_tokens))
+      std::cout << "invalid input accepted" << std::endl;
+    else
+      std::cout << "invalid input rejected" << std::endl;
+
+    // A stale table file is rejected:
+    cf_grammar<symbol> h(symbol::start);
+    h.add_production(symbol::start, {symbol::number_list, symbol::eoi});
+    h.add_production(symbol::number_list, {symbol::number});
+    h.add_production(symbol::number_list, {symbol::number_list, symbol::comma, symbol::number});
+
+    h.wrap_up();
+
+    try {
+      const mapped_lr_table<symbol> stale(filename, h);
+      std::cout << "stale table file accepted" << std::endl;
+    }
+    catch (const std::string& e) {
+      std::cout << e << std::endl;
+    }
+  }
+  catch (const std::string& e) {
+    std::cout << e << std::endl;
+  }
+
+  std::remove(filename.c_str());
+  return 0;
+}
@@ -0,0 +1,31 @@
+#ifndef _NUMBER_LEXER_H_
+#define _NUMBER_LEXER_H_
+
+#include "../src/regex/regexast.hpp"
+
+/*
+ * Tokens of the generated DFA tests: "[0-9][0-9]*" is the token 1, "," the
+ * token 2, "if" the token 3 and "[a-z][a-z]*" the token 4.
+ */
+inline astRegexNode* number_lexer_ast() {
+  const std::vector<std::pair<char, char> > digits(1, std::make_pair('0', '9'));
+  astRegexNode* number(new astRegexConcat(new astRegexRange(digits, false),
+                                          new astRegexKleenStar(new astRegexRange(digits, false))));
+  number->setDelimiter(1);
+
+  astRegexNode* comma(new astRegexAlpha(','));
+  comma->setDelimiter(2);
+
+  astRegexNode* if_keyword(new astRegexConcat(new astRegexAlpha('i'), new astRegexAlpha('f')));
+  if_keyword->setDelimiter(3);
+
+  const std::vector<std::pair<char, char> > letters(1, std::make_pair('a', 'z'));
+  astRegexNode* identifier(new astRegexConcat(new astRegexRange(letters, false),
+                                              new astRegexKleenStar(new astRegexRange(letters, false))));
+  identifier->setDelimiter(4);
+
+  return new astRegexAltTopLevel(new astRegexAltTopLevel(number, comma),
+                                 new astRegexAltTopLevel(if_keyword, identifier));
+}
+
+#endif /* _NUMBER_LEXER_H_ */
@@ -0,0 +1,53 @@
+// DFA generated by writeRegexTables(). Do not edit.
+#ifndef _NUMBER_LEXER_DFA_H_
+#define _NUMBER_LEXER_DFA_H_
+
+#include <cstddef>
+#include <cstdint>
+
+template<typename = void>
+struct number_lexer_dfa {
+  static constexpr std::size_t stateCount = 5;
+  static constexpr std::size_t classCount = 6;
+
+  static constexpr std::uint8_t characterClasses[] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 3, 3, 3, 3, 3, 4, 3, 3, 5, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  };
+  static constexpr std::uint32_t transitions[] = {
+    0, 2, 3, 4, 4, 5, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0,
+    0, 0, 0, 0, 0, 4, 4, 4, 0, 0, 0, 4, 4, 4,
+  };
+  static constexpr std::uint32_t accepts[] = {
+    0, 2, 1, 4, 4, 4, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0,
+    0, 0, 0, 0, 0, 4, 4, 4, 0, 0, 0, 4, 3, 4,
+  };
+  static constexpr bool accepting[] = {
+    false, true, true, true, true,
+  };
+};
+
+template<typename T> constexpr std::size_t number_lexer_dfa<T>::stateCount;
+template<typename T> constexpr std::size_t number_lexer_dfa<T>::classCount;
+template<typename T> constexpr std::uint8_t number_lexer_dfa<T>::characterClasses[];
+template<typename T> constexpr std::uint32_t number_lexer_dfa<T>::transitions[];
+template<typename T> constexpr std::uint32_t number_lexer_dfa<T>::accepts[];
+template<typename T> constexpr bool number_lexer_dfa<T>::accepting[];
+
+typedef number_lexer_dfa<> number_lexer;
+
+#endif
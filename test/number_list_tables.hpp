@@ -0,0 +1,63 @@
+// Parse tables generated by write_lr_tables(). Do not edit.
+#ifndef _NUMBER_LIST_PARSER_TABLES_H_
+#define _NUMBER_LIST_PARSER_TABLES_H_
+
+#include <cstddef>
+#include <cstdint>
+
+template<typename = void>
+struct number_list_parser_tables {
+  typedef symbol symbol_type;
+
+  static constexpr std::size_t state_count = 6;
+  static constexpr std::size_t terminal_count = 3;
+  static constexpr std::size_t non_terminal_count = 2;
+  static constexpr std::size_t production_count = 3;
+  static constexpr std::size_t accepting_state = 4;
+  static constexpr std::size_t terminal_column_count = 4;
+
+  static constexpr std::int32_t actions[] = {
+    0, 2, 0, -2, 0, 4, 5, 0, 0, 0, 2, 0,
+    0, 0, 0, -3, 0, 0,
+  };
+  static constexpr std::int32_t gotos[] = {
+    0, 3, 0, 0, 0, 0, 0, 6, 0, 0, 0, 0,
+  };
+  static constexpr std::uint32_t rule_lengths[] = {
+    2, 1, 3,
+  };
+  static constexpr std::uint32_t rule_lhs[] = {
+    0, 1, 1,
+  };
+  static constexpr std::uint32_t terminal_order[] = {
+    0, 1, 2,
+  };
+  static constexpr symbol_type terminals[] = {
+    static_cast<symbol>(1), static_cast<symbol>(2), static_cast<symbol>(3),
+  };
+  static constexpr symbol_type non_terminals[] = {
+    static_cast<symbol>(0), static_cast<symbol>(4),
+  };
+  static constexpr std::uint32_t terminal_columns[] = {
+    0, 1, 2, 3,
+  };
+};
+
+template<typename T> constexpr std::size_t number_list_parser_tables<T>::state_count;
+template<typename T> constexpr std::size_t number_list_parser_tables<T>::terminal_count;
+template<typename T> constexpr std::size_t number_list_parser_tables<T>::non_terminal_count;
+template<typename T> constexpr std::size_t number_list_parser_tables<T>::production_count;
+template<typename T> constexpr std::size_t number_list_parser_tables<T>::accepting_state;
+template<typename T> constexpr std::size_t number_list_parser_tables<T>::terminal_column_count;
+template<typename T> constexpr std::int32_t number_list_parser_tables<T>::actions[];
+template<typename T> constexpr std::int32_t number_list_parser_tables<T>::gotos[];
+template<typename T> constexpr std::uint32_t number_list_parser_tables<T>::rule_lengths[];
+template<typename T> constexpr std::uint32_t number_list_parser_tables<T>::rule_lhs[];
+template<typename T> constexpr std::uint32_t number_list_parser_tables<T>::terminal_order[];
+template<typename T> constexpr std::uint32_t number_list_parser_tables<T>::terminal_columns[];
+template<typename T> constexpr typename number_list_parser_tables<T>::symbol_type number_list_parser_tables<T>::terminals[];
+template<typename T> constexpr typename number_list_parser_tables<T>::symbol_type number_list_parser_tables<T>::non_terminals[];
+
+typedef number_list_parser_tables<> number_list_parser;
+
+#endif
@@ -64,6 +64,37 @@ int main() {
       std::cout << "parse succeed" << std::endl;
     else
       std::cout << "parse failed" << std::endl;
+
+    const packed_lr_table<symbol> packed(p);
+    dummy_token_source<symbol> packed_tokens({symbol::number, symbol::comma, symbol::number, symbol::eoi});
+
+    if (parse_input(packed, packed_tokens))
+      std::cout << "packed table parse succeed" << std::endl;
+    else
+      std::cout << "packed table parse failed" << std::endl;
+
+    const packed_lr_table<symbol, std::uint32_t> wide(p);
+    dummy_token_source<symbol> invalid_tokens({symbol::number, symbol::comma, symbol::eoi});
+
+    if (parse_input(wide, invalid_tokens))
+      std::cout << "invalid input accepted" << std::endl;
+    else
+      std::cout << "invalid input rejected" << std::endl;
+
+    const compressed_lr_table<symbol> compressed(p);
+    dummy_token_source<symbol> compressed_tokens({symbol::number, symbol::comma, symbol::number, symbol::eoi});
+
+    if (parse_input(compressed, compressed_tokens))
+      std::cout << "compressed table parse succeed" << std::endl;
+    else
+      std::cout << "compressed table parse failed" << std::endl;
+
+    dummy_token_source<symbol> compressed_invalid_tokens({symbol::number, symbol::number, symbol::eoi});
+
+    if (parse_input(compressed, compressed_invalid_tokens))
+      std::cout << "invalid input accepted" << std::endl;
+    else
+      std::cout << "invalid input rejected" << std::endl;
   }
   catch (const std::string& e) {
     std::cout << e << std::endl;
@@ -111,8 +111,8 @@ public:
   using token_type = token<symbol_type>;
   using node_type = basic_node;
   
-  node_type* build_node(std::list<node_type*>::iterator begin,
-                        std::list<node_type*>::iterator end,
+  node_type* build_node(node_type** begin,
+                        node_type** end,
                         unsigned int /* rule_id */,
                         symbol_type symbol) {
 
@@ -0,0 +1,111 @@
+#include "../src/parser/push_parser.hpp"
+#include "../src/parser/parse_tree.hpp"
+
+enum class symbol { start, eoi, number, comma, number_list };
+
+std::ostream& operator<<(std::ostream& stream, const symbol& s) {
+  switch (s) {
+  case symbol::start: stream << "<start>"; break;
+  case symbol::eoi: stream << "<eoi>"; break;
+  case symbol::number: stream << "<number>"; break;
+  case symbol::comma: stream << "<comma>"; break;
+  case symbol::number_list: stream << "<number_list>"; break;
+  }
+  return stream;
+}
+
+std::ostream& operator<<(std::ostream& stream, const push_status& s) {
+  switch (s) {
+  case push_status::need_more_input: stream << "need more input"; break;
+  case push_status::accepted: stream << "accepted"; break;
+  case push_status::error: stream << "error"; break;
+  }
+  return stream;
+}
+
+template<typename s_type>
+struct dummy_token {
+  using symbol_type = s_type;
+
+  symbol_type symbol;
+  unsigned int session;
+};
+
+using token_type = dummy_token<symbol>;
+using tree_factory = parse_tree::tree_factory<token_type>;
+using parser_type = push_parser<packed_lr_table<symbol>, tree_factory>;
+
+class show_visitor: public parse_tree::basic_visitor<token_type> {
+public:
+  show_visitor(): level(0) {}
+
+  void visit(parse_tree::terminal<token_type>* t) {
+    std::cout << std::string(level, ' ') << t->token().symbol
+              << " from session " << t->token().session << std::endl;
+  }
+
+  void visit(parse_tree::production<token_type>* p) {
+    std::cout << std::string(level, ' ') << p->symbol() << std::endl;
+    level += 2;
+    for (const auto& c: p->get_children())
+      c->accept(this);
+    level -= 2;
+  }
+
+private:
+  unsigned int level;
+};
+
+int main() {
+  try {
+    cf_grammar<symbol> g(symbol::start);
+    g.add_production(symbol::start, {symbol::number_list, symbol::eoi});
+    g.add_production(symbol::number_list, {symbol::number});
+    g.add_production(symbol::number_list, {symbol::number, symbol::comma, symbol::number_list});
+
+    g.wrap_up();
+
+    lr_parser<symbol> p(g);
+    const packed_lr_table<symbol> table(p);
+    tree_factory factory;
+
+    // Two sessions, whose tokens arrive interleaved:
+    parser_type first(table, factory), second(table, factory);
+    std::cout << "first: " << first.feed(token_type{symbol::number, 1}) << std::endl;
+    std::cout << "second: " << second.feed(token_type{symbol::number, 2}) << std::endl;
+    std::cout << "first: " << first.feed(token_type{symbol::comma, 1}) << std::endl;
+    std::cout << "second: " << second.finish(token_type{symbol::eoi, 2}) << std::endl;
+    std::cout << "first: " << first.feed(token_type{symbol::number, 1}) << std::endl;
+    std::cout << "first: " << first.finish(token_type{symbol::eoi, 1}) << std::endl;
+
+    show_visitor v;
+    for (parser_type* session: {&first, &second}) {
+      parse_tree::node<token_type>* tree(session->result());
+      tree->accept(&v);
+      delete tree;
+    }
+
+    // A session takes no more tokens once accepted, until it is reset:
+    std::cout << "first: " << first.feed(token_type{symbol::number, 1}) << std::endl;
+
+    // A syntax error is reported by the status:
+    first.reset();
+    std::cout << "first: " << first.feed(token_type{symbol::comma, 1}) << ", expected:";
+    for (const auto& s: first.expected_symbols())
+      std::cout << " " << s;
+    std::cout << std::endl;
+
+    first.reset();
+    first.feed(token_type{symbol::number, 1});
+    first.feed(token_type{symbol::comma, 1});
+    std::cout << "first: " << first.finish(token_type{symbol::eoi, 1}) << ", expected:";
+    for (const auto& s: first.expected_symbols())
+      std::cout << " " << s;
+    std::cout << std::endl;
+  }
+  catch (const std::string& e) {
+    std::cout << e << std::endl;
+  }
+
+  return 0;
+}
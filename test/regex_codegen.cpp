@@ -0,0 +1,13 @@
+#include <iostream>
+
+#include "number_lexer.hpp"
+
+int main() {
+  astRegexNode* ast(number_lexer_ast());
+  regex r(ast);
+  delete ast;
+
+  writeRegexTables(std::cout, r, "number_lexer");
+
+  return 0;
+}
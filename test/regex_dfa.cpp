@@ -0,0 +1,58 @@
+#include <iostream>
+#include <sstream>
+
+#include "number_lexer.hpp"
+
+// DFA of number_lexer_ast(), written by test_regex_codegen:
+#include "number_lexer_dfa.hpp"
+
+/*
+ * Match the tokens of text one after the other, with the regex r and with
+ * the generated DFA, which must find the same tokens. The characters which
+ * start no token are skipped.
+ */
+void tokenize(regex& r, const std::string& text) {
+  std::istringstream regex_stream(text), dfa_stream(text);
+  CharInput regex_input(&regex_stream), dfa_input(&dfa_stream);
+
+  std::cout << "\"" << text << "\":";
+  while (dfa_input.good()) {
+    std::size_t length(0);
+    unsigned int token_id(0);
+    const bool matched(match_regex_length(r, regex_input, length, token_id));
+
+    std::string token;
+    unsigned int dfa_token_id(0);
+    const bool dfa_matched(match_regex_longest<number_lexer>(dfa_input, token, dfa_token_id));
+
+    if (matched != dfa_matched
+        or (matched and (token.size() != length or dfa_token_id != token_id))) {
+      std::cout << " the generated DFA does not match the regex" << std::endl;
+      return;
+    }
+
+    if (matched) {
+      regex_input.skip(length);
+      std::cout << " " << token << ":" << token_id;
+    } else {
+      regex_input.skip(1);
+      dfa_input.skip(1);
+      std::cout << " ?";
+    }
+  }
+  std::cout << std::endl;
+}
+
+int main() {
+  astRegexNode* ast(number_lexer_ast());
+  regex r(ast);
+  delete ast;
+
+  tokenize(r, "12,345");
+  tokenize(r, "if,iffy,i");
+  tokenize(r, "7up if");
+  tokenize(r, "x9,Z");
+  tokenize(r, "");
+
+  return 0;
+}
@@ -0,0 +1,43 @@
+#include <iostream>
+#include <sstream>
+
+#include "../src/regex/regexast.hpp"
+
+void match(regex& r, const std::string& text) {
+  std::istringstream stream(text);
+  CharInput input(&stream);
+  std::size_t length(0);
+  unsigned int token_id(0);
+
+  std::cout << "\"" << text << "\": ";
+  if (match_regex_length(r, input, length, token_id))
+    std::cout << "token " << token_id << " of length " << length << std::endl;
+  else
+    std::cout << "no match" << std::endl;
+}
+
+int main() {
+  // Token 1 is "ac|bc", whose states after "a" and after "b" are equivalent,
+  //  and token 2 is "d":
+  astRegexNode* ac(new astRegexConcat(new astRegexAlpha('a'), new astRegexAlpha('c')));
+  astRegexNode* bc(new astRegexConcat(new astRegexAlpha('b'), new astRegexAlpha('c')));
+  astRegexNode* first(new astRegexAlt(ac, bc));
+  first->setDelimiter(1);
+  astRegexNode* second(new astRegexAlpha('d'));
+  second->setDelimiter(2);
+
+  astRegexNode* ast(new astRegexAltTopLevel(first, second));
+  regex r(ast);
+  delete ast;
+
+  std::cout << "states: " << r.stateCount()
+            << " (" << r.unminimizedStateCount << " before minimization)" << std::endl;
+
+  match(r, "ac");
+  match(r, "bc");
+  match(r, "dc");
+  match(r, "ab");
+  match(r, "c");
+
+  return 0;
+}
@@ -0,0 +1,112 @@
+#include <memory>
+
+#include "../src/parser/parse_input.hpp"
+
+/*
+ * The arithmetic expression grammar:
+ *  start = expr eoi
+ *  expr = expr plus term | term
+ *  term = term times factor | factor
+ *  factor = number | lparen expr rparen
+ */
+enum class symbol { start, eoi, number, plus, times, lparen, rparen, expr, term, factor };
+
+std::ostream& operator<<(std::ostream& stream, const symbol& s) {
+  switch (s) {
+  case symbol::start: stream << "<start>"; break;
+  case symbol::eoi: stream << "<eoi>"; break;
+  case symbol::number: stream << "<number>"; break;
+  case symbol::plus: stream << "<plus>"; break;
+  case symbol::times: stream << "<times>"; break;
+  case symbol::lparen: stream << "<lparen>"; break;
+  case symbol::rparen: stream << "<rparen>"; break;
+  case symbol::expr: stream << "<expr>"; break;
+  case symbol::term: stream << "<term>"; break;
+  case symbol::factor: stream << "<factor>"; break;
+  }
+  return stream;
+}
+
+template<typename s_type>
+struct dummy_token {
+  using symbol_type = s_type;
+
+  symbol_type symbol;
+  long value;
+
+  std::string render_coordinates() const { return ""; }
+  dummy_token* copy() const { return new dummy_token(*this); }
+};
+
+using number_token = dummy_token<symbol>;
+
+class dummy_token_source {
+public:
+  using symbol_type = symbol;
+  using token_type = number_token;
+
+  dummy_token_source(const std::vector<token_type>& tokens): tokens(tokens), current(0) {}
+
+  const token_type& get() const { return tokens[current]; }
+  void next() { ++current; }
+
+private:
+  std::vector<token_type> tokens;
+  std::size_t current;
+};
+
+int main() {
+  try {
+    cf_grammar<symbol> g(symbol::start);
+    g.add_production(symbol::start, {symbol::expr, symbol::eoi});
+    g.add_production(symbol::expr, {symbol::expr, symbol::plus, symbol::term});
+    g.add_production(symbol::expr, {symbol::term});
+    g.add_production(symbol::term, {symbol::term, symbol::times, symbol::factor});
+    g.add_production(symbol::term, {symbol::factor});
+    g.add_production(symbol::factor, {symbol::number});
+    g.add_production(symbol::factor, {symbol::lparen, symbol::expr, symbol::rparen});
+
+    g.wrap_up();
+
+    lr_parser<symbol> p(g, lookahead_method::lalr);
+
+    // The unit productions keep the value of their child:
+    semantic_actions<long, number_token> actions([](const number_token& t) { return t.value; });
+    actions.set(1, [](long* v, long*) { return v[0] + v[2]; });
+    actions.set(3, [](long* v, long*) { return v[0] * v[2]; });
+    actions.set(6, [](long* v, long*) { return v[1]; });
+
+    // 2 * (3 + 4) + 5:
+    const std::vector<number_token> input({{symbol::number, 2}, {symbol::times, 0}, {symbol::lparen, 0},
+          {symbol::number, 3}, {symbol::plus, 0}, {symbol::number, 4}, {symbol::rparen, 0},
+          {symbol::plus, 0}, {symbol::number, 5}, {symbol::eoi, 0}});
+
+    dummy_token_source tokens(input);
+    std::cout << "lr parser: " << parse_input_to_value(p, tokens, actions) << std::endl;
+
+    table_options options;
+    options.unit_rule_elimination = true;
+    options.semantic_productions = actions.semantic_productions();
+    const compressed_lr_table<symbol> bypassed(p, options);
+    dummy_token_source bypassed_tokens(input);
+    std::cout << "unit rule elimination: " << parse_input_to_value(bypassed, bypassed_tokens, actions) << std::endl;
+
+    // Values which are not copyable are moved:
+    typedef std::unique_ptr<std::string> text;
+    semantic_actions<text, number_token> show([](const number_token& t) {
+        return text(new std::string(t.symbol == symbol::number ? std::to_string(t.value) : ""));
+      });
+    show.set(1, [](text* v, text*) { return text(new std::string("(+ " + *v[0] + " " + *v[2] + ")")); });
+    show.set(3, [](text* v, text*) { return text(new std::string("(* " + *v[0] + " " + *v[2] + ")")); });
+    show.set(6, [](text* v, text*) { return std::move(v[1]); });
+
+    const packed_lr_table<symbol> packed(p);
+    dummy_token_source packed_tokens(input);
+    std::cout << "packed table: " << *parse_input_to_value(packed, packed_tokens, show) << std::endl;
+  }
+  catch (const std::string& e) {
+    std::cout << e << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,68 @@
+#include "../src/parser/parse_input.hpp"
+#include "../src/parser/static_lr_table.hpp"
+
+enum class symbol { start, eoi, number, comma, number_list };
+
+// Tables of the number list grammar, written by test_lr_table_codegen:
+#include "number_list_tables.hpp"
+
+template<typename s_type>
+struct dummy_token {
+  using symbol_type = s_type;
+
+  symbol_type symbol;
+
+  std::string render_coordinates() const { return ""; }
+  dummy_token* copy() const { return new dummy_token(*this); }
+};
+
+template<typename symbol_t>
+class dummy_token_source {
+public:
+  using symbol_type = symbol_t;
+  using token_type = dummy_token<symbol_type>;
+
+  dummy_token_source(const std::vector<symbol_type>& symbols): tokens(), current(0) {
+    for (const auto& s: symbols)
+      tokens.push_back(token_type{s});
+  }
+
+  const token_type& get() const { return tokens[current]; }
+  void next() { ++current; }
+
+private:
+  std::vector<token_type> tokens;
+  std::size_t current;
+};
+
+int main() {
+  try {
+    dummy_token_source<symbol> tokens({symbol::number, symbol::comma, symbol::number, symbol::comma, symbol::number, symbol::eoi});
+    if (static_parse_input<number_list_parser>(tokens))
+      std::cout << "static parse succeed" << std::endl;
+    else
+      std::cout << "static parse failed" << std::endl;
+
+    dummy_token_source<symbol> invalid_tokens({symbol::number, symbol::comma, symbol::eoi});
+    if (static_parse_input<number_list_parser>(invalid_tokens))
+      std::cout << "invalid input accepted" << std::endl;
+    else
+      std::cout << "invalid input rejected" << std::endl;
+
+    const static_lr_table<number_list_parser> table;
+    dummy_token_source<symbol> table_tokens({symbol::number, symbol::comma, symbol::number, symbol::eoi});
+    if (parse_input(table, table_tokens))
+      std::cout << "static table parse succeed" << std::endl;
+    else
+      std::cout << "static table parse failed" << std::endl;
+
+    dummy_token_source<symbol> unknown_tokens({symbol::number, symbol::number_list, symbol::eoi});
+    static_parse_input<number_list_parser>(unknown_tokens);
+    std::cout << "unknown terminal accepted" << std::endl;
+  }
+  catch (const std::string& e) {
+    std::cout << e << std::endl;
+  }
+
+  return 0;
+}
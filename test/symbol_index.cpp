@@ -0,0 +1,76 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "../src/parser/symbol_traits.hpp"
+#include "../src/parser/lr_table_codegen.hpp"
+
+// The end of input is often numbered -1, below the other symbols:
+enum class symbol : int { eoi = -1, number, comma, start, number_list };
+
+std::ostream& operator<<(std::ostream& stream, const symbol& s) {
+  switch (s) {
+  case symbol::eoi: stream << "<eoi>"; break;
+  case symbol::number: stream << "<number>"; break;
+  case symbol::comma: stream << "<comma>"; break;
+  case symbol::start: stream << "<start>"; break;
+  case symbol::number_list: stream << "<number_list>"; break;
+  }
+  return stream;
+}
+
+enum class unsigned_symbol : unsigned char { a, b, c = 200 };
+
+template<typename symbol_type>
+void find(const symbol_index<symbol_type>& index, const symbol_type& s, const std::string& name) {
+  std::size_t column(0);
+  std::cout << "  " << name << ": ";
+  if (index.find(s, column))
+    std::cout << "column " << column << std::endl;
+  else
+    std::cout << "no column" << std::endl;
+}
+
+int main() {
+  const std::map<symbol, unsigned int> terminals({{symbol::eoi, 0}, {symbol::number, 1}, {symbol::comma, 2}});
+  std::cout << "negative enumeration value, dense columns: "
+            << dense_columns(terminals).size() << std::endl;
+  const symbol_index<symbol> negative(terminals);
+  find(negative, symbol::eoi, "eoi");
+  find(negative, symbol::number, "number");
+  find(negative, symbol::comma, "comma");
+  find(negative, symbol::start, "start");
+
+  const std::map<unsigned_symbol, unsigned int> unsigned_terminals({{unsigned_symbol::a, 0}, {unsigned_symbol::c, 1}});
+  std::cout << "unsigned enumeration, dense columns: "
+            << dense_columns(unsigned_terminals).size() << std::endl;
+  const symbol_index<unsigned_symbol> unsigned_index(unsigned_terminals);
+  find(unsigned_index, unsigned_symbol::a, "a");
+  find(unsigned_index, unsigned_symbol::b, "b");
+  find(unsigned_index, unsigned_symbol::c, "c");
+
+  const std::map<int, unsigned int> integers({{-2, 0}, {3, 1}, {1000000, 2}});
+  std::cout << "sparse integers, dense columns: " << dense_columns(integers).size() << std::endl;
+  const symbol_index<int> integer_index(integers);
+  find(integer_index, -2, "-2");
+  find(integer_index, 3, "3");
+  find(integer_index, 1000000, "1000000");
+  find(integer_index, -1, "-1");
+
+  // The generated tables find the negative terminal by binary search:
+  cf_grammar<symbol> g(symbol::start);
+  g.add_production(symbol::start, {symbol::number_list, symbol::eoi});
+  g.add_production(symbol::number_list, {symbol::number});
+  g.add_production(symbol::number_list, {symbol::number, symbol::comma, symbol::number_list});
+  g.wrap_up();
+
+  lr_parser<symbol> p(g);
+  std::ostringstream header;
+  write_lr_tables(header, p, "negative_eoi_parser", "symbol");
+  std::istringstream lines(header.str());
+  for (std::string line; std::getline(lines, line);)
+    if (line.find("terminal_column_count =") != std::string::npos)
+      std::cout << "generated tables:" << line << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,114 @@
+#include <sstream>
+
+#include "../src/parser/parse_input.hpp"
+#include "../src/parser/parse_tree.hpp"
+#include "../src/regex/regexast.hpp"
+#include "../src/regex/regex_token_source.hpp"
+
+enum class symbol { start, eoi, number, comma, number_list };
+
+std::ostream& operator<<(std::ostream& stream, const symbol& s) {
+  switch (s) {
+  case symbol::start: stream << "<start>"; break;
+  case symbol::eoi: stream << "<eoi>"; break;
+  case symbol::number: stream << "<number>"; break;
+  case symbol::comma: stream << "<comma>"; break;
+  case symbol::number_list: stream << "<number_list>"; break;
+  }
+  return stream;
+}
+
+using token_type = token_view<symbol>;
+using token_source = regex_token_source<symbol>;
+
+// Print the tree, reading the lexemes of the leaves back from the input:
+class show_visitor: public parse_tree::basic_visitor<token_type> {
+public:
+  show_visitor(const token_source& source): source(source), level(0) {}
+
+  void visit(parse_tree::terminal<token_type>* t) {
+    std::cout << std::string(level, ' ') << t->token().symbol
+              << " (" << source.lexeme(t->token()) << ") at "
+              << t->token().render_coordinates() << std::endl;
+  }
+
+  void visit(parse_tree::production<token_type>* p) {
+    std::cout << std::string(level, ' ') << p->symbol() << std::endl;
+    level += 2;
+    for (const auto& c: p->get_children())
+      c->accept(this);
+    level -= 2;
+  }
+
+private:
+  const token_source& source;
+  unsigned int level;
+};
+
+astRegexNode* digits() {
+  const std::vector<std::pair<char, char> > range(1, std::make_pair('0', '9'));
+  return new astRegexConcat(new astRegexRange(range, false),
+                            new astRegexKleenStar(new astRegexRange(range, false)));
+}
+
+int main() {
+  try {
+    cf_grammar<symbol> g(symbol::start);
+    g.add_production(symbol::start, {symbol::number_list, symbol::eoi});
+    g.add_production(symbol::number_list, {symbol::number});
+    g.add_production(symbol::number_list, {symbol::number, symbol::comma, symbol::number_list});
+
+    g.wrap_up();
+
+    lr_parser<symbol> p(g);
+
+    // Tokens "[0-9][0-9]*" and ",", skipper "[\n ]*":
+    astRegexNode* number(digits());
+    number->setDelimiter(1);
+    astRegexNode* comma(new astRegexAlpha(','));
+    comma->setDelimiter(2);
+    astRegexNode* tokens_ast(new astRegexAltTopLevel(number, comma));
+    regex tokens(tokens_ast);
+    delete tokens_ast;
+
+    astRegexNode* skipper_ast(new astRegexKleenStar(new astRegexRange({{'\n', '\n'}, {' ', ' '}}, false)));
+    skipper_ast->setDelimiter(1);
+    regex skipper(skipper_ast);
+    delete skipper_ast;
+
+    std::istringstream stream("12, 345,\n  6789");
+    CharInput input(&stream);
+    token_source source(tokens, &skipper, {symbol::number, symbol::comma}, symbol::eoi, input);
+
+    parse_tree::tree_factory<token_type> factory;
+    parse_tree::node<token_type>* tree(parse_input_to_tree(p, source, factory));
+
+    show_visitor v(source);
+    tree->accept(&v);
+    delete tree;
+
+    // When streaming, the text of each token is released once it is read:
+    std::istringstream streamed_text("1, 22, 333");
+    CharInput streamed_input(&streamed_text);
+    token_source streamed(tokens, &skipper, {symbol::number, symbol::comma}, symbol::eoi, streamed_input);
+    const token_type first(streamed.get());
+    for (; streamed.get().symbol != symbol::eoi; streamed.next()) {
+      std::cout << streamed.lexeme(streamed.get()) << " ";
+      streamed.release_before(streamed.get());
+    }
+    std::cout << std::endl;
+
+    try {
+      streamed.lexeme(first);
+      std::cout << "unexpected: the released lexeme is read" << std::endl;
+    }
+    catch (const std::string& e) {
+      std::cout << e << std::endl;
+    }
+  }
+  catch (const std::string& e) {
+    std::cout << e << std::endl;
+  }
+
+  return 0;
+}